@@ -0,0 +1,290 @@
+#include "include/tactical_view.h"
+#include "include/strategic_view.h"
+#include "include/asteroid.h"
+#include "include/missile_batch_item.h"
+#include "include/player_ship.h"
+#include "include/sensor_fov_item.h"
+#include "include/starfield.h"
+#include "include/globals.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QtWidgets>
+
+#include <algorithm>
+#include <random>
+
+
+/**
+ * Offscreen render benchmark for the tactical and strategic scenes.
+ *
+ * Builds both scenes with a synthetic scenario, then for a fixed number of frames
+ * drives their per-tick updates and renders each view into a QImage, timing the
+ * whole frame. A second pass paints every item on its own to attribute the cost
+ * to each item type. Runs on the offscreen platform, so it needs no display.
+ */
+
+namespace
+{
+
+struct Scenario
+{
+    int missiles;
+    int tracks;
+    int asteroids;
+    int sensors;
+    int frames;
+    int warmup;
+    QSize size;
+    uint32_t seed;
+};
+
+struct Stats
+{
+    QVector<qint64> frames; // Nanoseconds
+    QMap<QString, qint64> items; // Total nanoseconds per item type
+    QMap<QString, int> counts; // Items per type, per frame
+};
+
+QString getItemName(QGraphicsItem* item)
+{
+    if (dynamic_cast<Asteroid*>(item)) return "Asteroid";
+    if (dynamic_cast<MissileBatchItem*>(item)) return "MissileBatchItem";
+    if (dynamic_cast<PlayerShipItem*>(item)) return "PlayerShipItem";
+    if (dynamic_cast<Starfield*>(item)) return "Starfield";
+    if (dynamic_cast<AccelerationMarker*>(item)) return "AccelerationMarker";
+    if (dynamic_cast<GridLines*>(item)) return "GridLines";
+    if (dynamic_cast<PlayerSymbolItem*>(item)) return "PlayerSymbolItem";
+    if (dynamic_cast<SensorFOV*>(item)) return "SensorFOV";
+    if (dynamic_cast<StrategicSymbol*>(item)) return "StrategicSymbol";
+    if (dynamic_cast<TrackClusterItem*>(item)) return "TrackClusterItem";
+    if (dynamic_cast<VelocityMarker*>(item)) return "VelocityMarker";
+    return "Other";
+}
+
+/**
+ * Renders the whole view, as it would be drawn on screen.
+ */
+qint64 renderView(QGraphicsView* view, QImage& image)
+{
+    QElapsedTimer timer;
+    timer.start();
+    image.fill(Qt::black);
+    QPainter painter(&image);
+    view->render(&painter);
+    painter.end();
+    return timer.nsecsElapsed();
+}
+
+/**
+ * Paints every visible item on its own, accumulating the time against its type.
+ */
+void profileItems(QGraphicsView* view, QImage& image, Stats& stats, bool record)
+{
+    QPainter painter(&image);
+    QTransform viewTransform = view->viewportTransform();
+    QElapsedTimer timer;
+    for (auto item : view->scene()->items())
+    {
+        if (!item->isVisible()) {
+            continue;
+        }
+        QStyleOptionGraphicsItem option;
+        option.exposedRect = item->boundingRect();
+        painter.save();
+        painter.setTransform(item->sceneTransform() * viewTransform);
+        timer.start();
+        item->paint(&painter, &option, nullptr);
+        qint64 elapsed = timer.nsecsElapsed();
+        painter.restore();
+        if (record) {
+            stats.items[getItemName(item)] += elapsed;
+        }
+    }
+}
+
+void countItems(QGraphicsScene* scene, Stats& stats)
+{
+    stats.counts.clear();
+    for (auto item : scene->items()) {
+        if (item->isVisible()) {
+            stats.counts[getItemName(item)]++;
+        }
+    }
+}
+
+qreal getPercentile(QVector<qint64> sorted, qreal p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    int i = qBound(0, qCeil(p * sorted.size()) - 1, sorted.size() - 1);
+    return sorted[i] * 1e-6;
+}
+
+void report(const QString& name, Stats& stats, int frames)
+{
+    QTextStream out(stdout);
+    std::sort(stats.frames.begin(), stats.frames.end());
+    out << name << " frame_ms"
+        << " p50=" << getPercentile(stats.frames, 0.5)
+        << " p90=" << getPercentile(stats.frames, 0.9)
+        << " p99=" << getPercentile(stats.frames, 0.99)
+        << " max=" << getPercentile(stats.frames, 1.0) << "\n";
+    for (auto it = stats.items.cbegin(); it != stats.items.cend(); it++)
+    {
+        out << name << " item " << it.key()
+            << " count=" << stats.counts.value(it.key())
+            << " mean_ms=" << (it.value() * 1e-6 / frames) << "\n";
+    }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // Headless by default, so the harness runs without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offscreen render benchmark for the tactical and strategic scenes");
+    parser.addHelpOption();
+    QCommandLineOption missilesOption("missiles", "Number of missiles.", "N", "100");
+    QCommandLineOption tracksOption("tracks", "Number of strategic tracks.", "M", "100");
+    QCommandLineOption asteroidsOption("asteroids", "Number of asteroids.", "K", "20");
+    QCommandLineOption sensorsOption("sensors", "Number of sensor FOV items.", "S", "4");
+    QCommandLineOption framesOption("frames", "Number of timed frames.", "F", "600");
+    QCommandLineOption warmupOption("warmup", "Number of untimed frames first.", "W", "60");
+    QCommandLineOption widthOption("width", "Width of each view.", "pixels", "1024");
+    QCommandLineOption heightOption("height", "Height of each view.", "pixels", "720");
+    QCommandLineOption seedOption("seed", "Seed for the scenario layout.", "seed", "1");
+    parser.addOptions({missilesOption, tracksOption, asteroidsOption, sensorsOption, framesOption,
+                       warmupOption, widthOption, heightOption, seedOption});
+    parser.process(app);
+
+    Scenario scenario {parser.value(missilesOption).toInt(), parser.value(tracksOption).toInt(),
+                       parser.value(asteroidsOption).toInt(), parser.value(sensorsOption).toInt(),
+                       parser.value(framesOption).toInt(), parser.value(warmupOption).toInt(),
+                       QSize(parser.value(widthOption).toInt(), parser.value(heightOption).toInt()),
+                       parser.value(seedOption).toUInt()};
+
+    std::mt19937 rng(scenario.seed);
+    auto uniform = [&rng](qreal lo, qreal hi) { return std::uniform_real_distribution<qreal>(lo, hi)(rng); };
+
+    auto tacticalScene = new TacticalScene();
+    auto strategicScene = new StrategicScene();
+    auto tacticalView = tacticalScene->getView();
+    auto strategicView = strategicScene->getView();
+    tacticalView->resize(scenario.size);
+    strategicView->resize(scenario.size);
+
+    // Tactical contents, in world units around the player at the origin
+    PlayerShip player(Faction::Blue, 1);
+    player.handleAddPart(Component::ComponentType::Reactor, {2, 2}, TwoDeg::Up);
+    auto playerItem = static_cast<PlayerShipItem*>(player.getTacticalGraphicsItem());
+    tacticalScene->addContact(playerItem);
+
+    // Draws are sequenced explicitly, so the layout only depends on the seed
+    for (int i = 0; i < scenario.asteroids; i++)
+    {
+        qreal x = uniform(-500, 500);
+        qreal y = uniform(-350, 350);
+        qreal radius = uniform(5, 40);
+        tacticalScene->addAsteroid(new Asteroid(QColor(0, 255, 0), x, y, Vector(0, 0), 10, radius));
+    }
+
+    QVector<QPointF> missilePositions;
+    QVector<QPointF> missileVelocities;
+    auto batch = tacticalScene->getMissileBatch();
+    for (int i = 0; i < scenario.missiles; i++)
+    {
+        qreal x = uniform(-500, 500);
+        qreal y = uniform(-350, 350);
+        qreal vx = uniform(-2, 2);
+        qreal vy = uniform(-2, 2);
+        missilePositions << QPointF(x, y);
+        missileVelocities << QPointF(vx, vy);
+        batch->addMissile(missilePositions.last(), qAtan2(missileVelocities.last().y(), missileVelocities.last().x()));
+    }
+
+    // Strategic contents
+    QVector<SensorFOV*> sensors;
+    for (int i = 0; i < scenario.sensors; i++)
+    {
+        auto sensor = new SensorFOV(0.75, 0.75, M_PI*0.1);
+        strategicScene->addItem(sensor);
+        sensors << sensor;
+    }
+
+    QVector<ProcessedTrack> tracks(scenario.tracks);
+    for (int i = 0; i < scenario.tracks; i++)
+    {
+        tracks[i].uid = uint32_t(i + 2);
+        qreal x = uniform(-5e5, 5e5);
+        qreal y = uniform(-3.5e5, 3.5e5);
+        qreal vx = uniform(-50, 50);
+        qreal vy = uniform(-50, 50);
+        tracks[i].position = QPointF(x, y);
+        tracks[i].vel = QPointF(vx, vy);
+        tracks[i].faction = (i % 3 == 0) ? Faction::Red : Faction::Unknown;
+        tracks[i].isCurrent = (i % 2 == 0);
+    }
+
+    QImage image(scenario.size, QImage::Format_ARGB32_Premultiplied);
+    Stats tacticalStats;
+    Stats strategicStats;
+    Bearing angle(0);
+    Vector playerVel(0.5, 0.2);
+    Vector playerAcc(0, 0);
+    QPointF playerOffset(-0.5, -0.2);
+
+    for (int frame = 0; frame < scenario.warmup + scenario.frames; frame++)
+    {
+        bool record = frame >= scenario.warmup;
+
+        // Tick, the same per-frame updates the simulation loop drives
+        angle += 0.01;
+        playerItem->setShip(angle, player.getComponents(), player.getEngines(), player.getConfigRevision());
+        for (int i = 0; i < missilePositions.size(); i++)
+        {
+            missilePositions[i] += missileVelocities[i] + playerOffset;
+            batch->setMissile(i, missilePositions[i], qAtan2(missileVelocities[i].y(), missileVelocities[i].x()));
+        }
+        for (auto sensor : sensors) {
+            sensor->updateScan({0, 0}, angle(), 0.5*qSin(frame * 0.02));
+        }
+        for (auto& track : tracks) {
+            track.position += track.vel + playerOffset;
+        }
+        strategicScene->visualiseTracks(TrackView(tracks.constData(), tracks.constData() + tracks.size()));
+        tacticalScene->updateItems(playerOffset);
+        strategicScene->applyPlayerUpdate(playerOffset, angle, playerVel, playerAcc);
+
+        qint64 tacticalTime = renderView(tacticalView, image);
+        qint64 strategicTime = renderView(strategicView, image);
+        if (record)
+        {
+            tacticalStats.frames << tacticalTime;
+            strategicStats.frames << strategicTime;
+        }
+        profileItems(tacticalView, image, tacticalStats, record);
+        profileItems(strategicView, image, strategicStats, record);
+    }
+
+    countItems(tacticalScene, tacticalStats);
+    countItems(strategicScene, strategicStats);
+
+    QTextStream out(stdout);
+    out << "scenario missiles=" << scenario.missiles << " tracks=" << scenario.tracks
+        << " asteroids=" << scenario.asteroids << " sensors=" << scenario.sensors
+        << " frames=" << scenario.frames << " size=" << scenario.size.width() << "x" << scenario.size.height()
+        << " seed=" << scenario.seed << "\n";
+    out.flush();
+    report("tactical", tacticalStats, scenario.frames);
+    report("strategic", strategicStats, scenario.frames);
+    return 0;
+}
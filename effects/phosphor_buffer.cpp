@@ -0,0 +1,193 @@
+#include "phosphor_buffer.h"
+
+
+PhosphorBuffer::PhosphorBuffer(qreal decay, int downsample)
+    : mDecay(int(decay * 256)), mDownsample(downsample)
+{
+    mFadeTicks = int(qCeil(qLn(1.0 / 255.0) / qLn(decay)));
+    mDeposits.resize(mFadeTicks + 1);
+}
+
+void PhosphorBuffer::resize(QSize viewportSize)
+{
+    QSize size((viewportSize.width() + mDownsample - 1) / mDownsample,
+               (viewportSize.height() + mDownsample - 1) / mDownsample);
+    if (mImage.size() == size) {
+        return;
+    }
+    mImage = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    mImage.fill(Qt::transparent);
+    mScratch = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    mLitRect = QRect();
+    mDeposits.fill(QRect());
+    mScrollRemainder = QPointF();
+}
+
+void PhosphorBuffer::decay(QPointF scroll)
+{
+    QRect previous = mLitRect;
+    if (mLitRect.isEmpty())
+    {
+        mDirtyRect = QRect();
+        mScrollRemainder = QPointF();
+        return;
+    }
+
+    // Scrolls of less than a buffer pixel accumulate, so slow movement still moves the trails
+    mScrollRemainder += scroll / mDownsample;
+    QPoint shift(int(mScrollRemainder.x()), int(mScrollRemainder.y()));
+    mScrollRemainder -= shift;
+    if (!shift.isNull())
+    {
+        mScratch.fill(Qt::transparent);
+        QPainter painter(&mScratch);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(mLitRect.topLeft() + shift, mImage, mLitRect);
+        painter.end();
+        std::swap(mImage, mScratch);
+        for (auto& rect : mDeposits) {
+            rect.translate(shift);
+        }
+    }
+
+    // The oldest deposit has now fully faded, and its slot takes this tick's deposits
+    const int ticks = mDeposits.size();
+    mNewest = (mNewest + 1) % ticks;
+    mDeposits[mNewest] = QRect();
+
+    // The blur spreads each deposit by a pixel per tick of its age
+    mLitRect = QRect();
+    for (int age = 1; age < ticks; age++)
+    {
+        const QRect& rect = mDeposits[(mNewest + ticks - age) % ticks];
+        if (!rect.isEmpty()) {
+            mLitRect |= rect.adjusted(-age, -age, age, age);
+        }
+    }
+    mLitRect &= mImage.rect();
+    if (mLitRect.isEmpty())
+    {
+        // Fully faded, so there is nothing left to process until the next deposit
+        mImage.fill(Qt::transparent);
+        mDirtyRect = QRect(previous.topLeft() * mDownsample, previous.size() * mDownsample);
+        mScrollRemainder = QPointF();
+        return;
+    }
+    blurAndFade();
+
+    QRect lit = previous.united(mLitRect);
+    mDirtyRect = QRect(lit.topLeft() * mDownsample, lit.size() * mDownsample);
+}
+
+void PhosphorBuffer::blurAndFade()
+{
+    if (mLitRect.isEmpty()) {
+        return;
+    }
+    const int left = mLitRect.left();
+    const int right = mLitRect.right();
+    const int top = mLitRect.top();
+    const int bottom = mLitRect.bottom();
+    const int maxX = mImage.width() - 1;
+    const int maxY = mImage.height() - 1;
+
+    // Horizontal pass into the scratch image
+    for (int y = top; y <= bottom; y++)
+    {
+        const QRgb* src = reinterpret_cast<const QRgb*>(mImage.constScanLine(y));
+        QRgb* dst = reinterpret_cast<QRgb*>(mScratch.scanLine(y));
+        for (int x = left; x <= right; x++)
+        {
+            QRgb a = src[qMax(x - 1, 0)];
+            QRgb b = src[x];
+            QRgb c = src[qMin(x + 1, maxX)];
+            // Sum the channels pairwise (alpha/green and red/blue) in 16-bit lanes
+            quint64 ag = ((a >> 8) & 0x00ff00ff) + ((b >> 8) & 0x00ff00ff) + ((c >> 8) & 0x00ff00ff);
+            quint64 rb = (a & 0x00ff00ff) + (b & 0x00ff00ff) + (c & 0x00ff00ff);
+            ag = ((ag & 0xffff) * 85 >> 8) | ((((ag >> 16) & 0xffff) * 85 >> 8) << 16);
+            rb = ((rb & 0xffff) * 85 >> 8) | ((((rb >> 16) & 0xffff) * 85 >> 8) << 16);
+            dst[x] = QRgb((ag << 8) | rb);
+        }
+    }
+
+    // Vertical pass back into the image, fading as it goes
+    const quint32 scale = quint32(85 * mDecay) >> 8; // One third of the decay, in 8.8
+    for (int y = top; y <= bottom; y++)
+    {
+        const QRgb* up = reinterpret_cast<const QRgb*>(mScratch.constScanLine(qMax(y - 1, 0)));
+        const QRgb* mid = reinterpret_cast<const QRgb*>(mScratch.constScanLine(y));
+        const QRgb* down = reinterpret_cast<const QRgb*>(mScratch.constScanLine(qMin(y + 1, maxY)));
+        QRgb* dst = reinterpret_cast<QRgb*>(mImage.scanLine(y));
+        for (int x = left; x <= right; x++)
+        {
+            quint64 ag = ((up[x] >> 8) & 0x00ff00ff) + ((mid[x] >> 8) & 0x00ff00ff) + ((down[x] >> 8) & 0x00ff00ff);
+            quint64 rb = (up[x] & 0x00ff00ff) + (mid[x] & 0x00ff00ff) + (down[x] & 0x00ff00ff);
+            ag = ((ag & 0xffff) * scale >> 8) | ((((ag >> 16) & 0xffff) * scale >> 8) << 16);
+            rb = ((rb & 0xffff) * scale >> 8) | ((((rb >> 16) & 0xffff) * scale >> 8) << 16);
+            dst[x] = QRgb((ag << 8) | rb);
+        }
+    }
+}
+
+void PhosphorBuffer::deposit(QGraphicsItem* item, const QTransform& viewportTransform)
+{
+    deposit(item, viewportTransform, {item->boundingRect()});
+}
+
+void PhosphorBuffer::deposit(QGraphicsItem* item, const QTransform& viewportTransform, const QVector<QRectF>& parts)
+{
+    if (mImage.isNull() || parts.empty()) {
+        return;
+    }
+    QTransform transform = getBufferTransform(item, viewportTransform);
+
+    // Only the part of the item on screen is painted
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = transform.inverted().mapRect(QRectF(mImage.rect())).intersected(item->boundingRect());
+    if (option.exposedRect.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(&mImage);
+    painter.setTransform(transform);
+    item->paint(&painter, &option, nullptr);
+    painter.end();
+
+    for (const auto& part : parts) {
+        addDeposit(transform.mapRect(part).toAlignedRect());
+    }
+}
+
+void PhosphorBuffer::deposit(const QPolygonF& poly, const QTransform& viewportTransform)
+{
+    if (mImage.isNull()) {
+        return;
+    }
+    QTransform transform = viewportTransform * QTransform::fromScale(1.0 / mDownsample, 1.0 / mDownsample);
+
+    QPainter painter(&mImage);
+    painter.setTransform(transform);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QColor(sPhosphorColour));
+    painter.drawPolygon(poly);
+    painter.end();
+
+    addDeposit(transform.mapRect(poly.boundingRect()).toAlignedRect().adjusted(-1, -1, 1, 1));
+}
+
+void PhosphorBuffer::addDeposit(const QRect& rect)
+{
+    QRect lit = rect.intersected(mImage.rect());
+    mDeposits[mNewest] |= lit;
+    mLitRect |= lit;
+}
+
+void PhosphorBuffer::draw(QPainter* painter) const
+{
+    if (mLitRect.isEmpty()) {
+        return;
+    }
+    QRectF target(mLitRect.topLeft() * mDownsample, mLitRect.size() * mDownsample);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    painter->drawImage(target, mImage, mLitRect);
+}
@@ -0,0 +1,103 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Screen-space phosphor persistence, as on a CRT.
+ *
+ * Contacts are drawn into a single (downsampled) accumulation image every tick.
+ * Each tick the previous image is scrolled with the world, blurred once and
+ * multiplied by a decay factor, so the cost of the trails depends on the lit
+ * area of the screen rather than on the number of contacts leaving them.
+ */
+class PhosphorBuffer
+{
+public:
+    /**
+     * @param decay - Fraction of the brightness kept from one tick to the next.
+     * @param downsample - Viewport pixels per buffer pixel (per axis).
+     */
+    explicit PhosphorBuffer(qreal decay = 0.8, int downsample = 2);
+
+    /**
+     * Matches the buffer to the viewport, clearing it if the size changed.
+     */
+    void resize(QSize viewportSize);
+
+    /**
+     * Scrolls, blurs and fades the persisted image.
+     * @param scroll - Movement of the world since the last tick, in viewport pixels.
+     */
+    void decay(QPointF scroll);
+
+    /**
+     * Draws the item into the buffer.
+     * @param item - The item to draw.
+     * @param viewportTransform - Transform from scene to viewport coordinates.
+     */
+    void deposit(QGraphicsItem* item, const QTransform& viewportTransform);
+
+    /**
+     * Draws the item into the buffer, lighting only the given parts of it.
+     * @param item - The item to draw.
+     * @param viewportTransform - Transform from scene to viewport coordinates.
+     * @param parts - The areas the item actually draws into, in item coordinates.
+     */
+    void deposit(QGraphicsItem* item, const QTransform& viewportTransform, const QVector<QRectF>& parts);
+
+    /**
+     * Draws the outline of the polygon into the buffer.
+     * @param poly - The polygon, in scene coordinates.
+     * @param viewportTransform - Transform from scene to viewport coordinates.
+     */
+    void deposit(const QPolygonF& poly, const QTransform& viewportTransform);
+
+    /**
+     * Draws the buffer over the viewport. The painter must be in viewport coordinates.
+     */
+    void draw(QPainter* painter) const;
+
+    /**
+     * Returns the area of the viewport that is (or was until this tick) lit.
+     */
+    QRect getDirtyRect() const
+    {
+        return mDirtyRect.united(QRect(mLitRect.topLeft() * mDownsample, mLitRect.size() * mDownsample));
+    }
+
+    bool isLit() const { return !mLitRect.isEmpty(); }
+
+private:
+    /**
+     * Returns the transform from item to buffer coordinates.
+     */
+    QTransform getBufferTransform(QGraphicsItem* item, const QTransform& viewportTransform) const
+    {
+        return item->sceneTransform() * viewportTransform * QTransform::fromScale(1.0 / mDownsample, 1.0 / mDownsample);
+    }
+
+    /**
+     * Adds an area lit this tick, in buffer pixels.
+     */
+    void addDeposit(const QRect& rect);
+
+    /**
+     * Separable 3x3 box blur of the lit area, with the decay applied in the second pass.
+     */
+    void blurAndFade();
+
+    constexpr static QRgb sPhosphorColour {0xff00ff00};
+
+    int mDecay; // 8.8 fixed point
+    int mDownsample;
+    int mFadeTicks; // Ticks until a deposit has faded to nothing
+
+    QImage mImage; // ARGB32_Premultiplied
+    QImage mScratch;
+    QRect mLitRect; // Buffer pixels, the deposits of the last mFadeTicks ticks grown by the blur since
+    QVector<QRect> mDeposits; // Ring of the buffer pixels lit by each of the last mFadeTicks + 1 ticks
+    int mNewest {0}; // Slot in mDeposits of the current tick
+    QRect mDirtyRect; // Viewport pixels
+    QPointF mScrollRemainder; // Buffer pixels of scroll not yet applied
+};
@@ -0,0 +1,84 @@
+#include "spsc_queue.h"
+
+#include <QtWidgets>
+
+#include <atomic>
+
+#pragma once
+
+
+/**
+ * Records the tactical and strategic views to an image sequence without blocking the GUI.
+ *
+ * Each captured frame copies both views side by side into one of a small pool
+ * of reusable images, which is handed to an encoder thread through a bounded
+ * queue. The views are copied from the window's backing store, i.e. the frame
+ * that was last painted, so the GUI thread does not render the scenes twice.
+ * Only if the window is not painted into a 32 bit RGB image are the views
+ * rendered again. The encoder writes the image and hands the buffer back. If
+ * every buffer is still waiting to be encoded, the frame is dropped and
+ * counted instead.
+ */
+class FrameRecorder
+{
+public:
+    enum class Format
+    {
+        Raw, // Binary PPM, cheap to write but large
+        Png,
+    };
+
+    /**
+     * @param directory - Directory the sequence is written to, created if needed.
+     * @param format - Image format of each frame.
+     * @param buffers - Number of frames that may be waiting on the encoder at once.
+     */
+    FrameRecorder(const QString& directory, Format format, int buffers = 4);
+    ~FrameRecorder();
+
+    /**
+     * Copies the views into a free buffer and queues it for encoding. GUI thread only.
+     * @return False if the frame was dropped because the encoder has fallen behind.
+     */
+    bool capture(QGraphicsView* left, QGraphicsView* right);
+
+    /**
+     * Encodes every queued frame, then stops the encoder thread.
+     */
+    void stop();
+
+    const QString& getDirectory() const { return mDirectory; }
+    int getCapturedFrames() const { return mCaptured; }
+    int getDroppedFrames() const { return mDropped; }
+    int getWrittenFrames() const { return mWritten.load(std::memory_order_relaxed); }
+    int getFailedFrames() const { return mFailed.load(std::memory_order_relaxed); }
+
+private:
+    struct Frame
+    {
+        int buffer {-1};
+        int number {0};
+    };
+
+    void encode();
+
+    /**
+     * Copies the last painted frame of the view into the image at the given position.
+     * @return False if the view's window is not painted into an image in memory.
+     */
+    static bool copyPainted(QGraphicsView* view, QImage& image, QPoint at);
+
+    QString mDirectory;
+    Format mFormat;
+    QVector<QImage> mBuffers;
+    SpscQueue<Frame> mQueued; // GUI -> encoder
+    SpscQueue<int> mFree; // Encoder -> GUI, indices into mBuffers
+    QSemaphore mPending; // Counts queued frames, so the encoder can sleep while idle
+    QThread* mThread;
+    std::atomic<bool> mStopping {false};
+
+    int mCaptured {0};
+    int mDropped {0};
+    std::atomic<int> mWritten {0};
+    std::atomic<int> mFailed {0};
+};
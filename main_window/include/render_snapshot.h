@@ -0,0 +1,53 @@
+#include "include/track_table.h"
+#include "include/component.h"
+#include "include/engine.h"
+#include "include/sensor_fov_item.h"
+#include "include/vector.h"
+
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Everything the scenes need to draw one simulation tick. Snapshots are
+ * written by the simulation thread and only ever read by the GUI thread,
+ * so scene items never hold references into live simulation state.
+ */
+struct RenderSnapshot
+{
+    struct MissileState
+    {
+        QPointF position;
+        qreal atan2;
+    };
+
+    struct SensorState
+    {
+        SensorFOV* item; // Owned by the sensor, only touched by the GUI thread
+        QPointF position;
+        qreal boreAngle;
+        qreal scanAngle;
+        bool isActive;
+    };
+
+    uint32_t timestamp {0};
+
+    // Sum of every player offset so far, the consumer applies the difference
+    // since the last snapshot it drew so skipped ticks are not lost
+    QPointF totalOffset;
+
+    Bearing playerAtan2 {0};
+    Vector playerVel = Vector(0, 0);
+    Vector playerAcc = Vector(0, 0);
+    QVector<Component> playerComponents;
+    QVector<Engine> playerEngines;
+    uint32_t playerConfigRevision {0};
+    QVector<SensorState> playerSensors;
+
+    QVector<MissileState> missiles;
+    QVector<ProcessedTrack> tracks; // The player faction's track picture
+};
+
+Q_DECLARE_TYPEINFO(RenderSnapshot::MissileState, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(RenderSnapshot::SensorState, Q_PRIMITIVE_TYPE);
@@ -4,16 +4,32 @@
 #include "include/config_view.h"
 #include "global_config.h"
 #include "include/guidance_processor.h"
+#include "include/occlusion_grid.h"
+#include "include/command_script.h"
+#include "frame_recorder.h"
+#include "render_snapshot.h"
+#include "spsc_queue.h"
+#include "telemetry_sink.h"
+#include "triple_buffer.h"
 
 #include <QFrame>
 #include <QGraphicsView>
 #include <QtWidgets>
 
+#include <atomic>
+#include <memory>
+
 #pragma once
 
 
 /**
  * Controller for linking the updates of the player ship, the world and the terminal.
+ *
+ * Once started, the world is stepped on its own thread at the target tick rate.
+ * Each tick publishes a RenderSnapshot through a triple buffer, which the GUI
+ * thread applies to the scenes at the frame rate, so a slow paint never stalls
+ * the physics. Input reaches the simulation thread through a command queue,
+ * and a running script applies its pre-compiled commands on their exact ticks.
  */
 class SimulationLoop : public QObject
 {
@@ -24,7 +40,19 @@ public:
     void initPlayer();
     void initMissile(qreal x, qreal y);
 
+    /**
+     * Starts the simulation thread, the ship must not be reconfigured after this.
+     */
     void start();
+
+    /**
+     * Stops the simulation thread and waits for it to finish its tick.
+     */
+    void stop();
+
+    /**
+     * Applies the latest render snapshot (if there is a new one) to the scenes.
+     */
     void timerEvent(QTimerEvent* event) override;
 
 public Q_SLOTS:
@@ -35,6 +63,12 @@ public Q_SLOTS:
     void rotate(int degrees);
     void addSensors(QVector<std::shared_ptr<Sensor>> sensors);
     void clearSensors(QVector<std::shared_ptr<Sensor>> sensors);
+    void startCapture(bool png);
+    void stopCapture();
+    void runScript(std::shared_ptr<const CommandScript> script);
+    void stopScript();
+    void startTelemetry(const QString& target, bool isSocket);
+    void stopTelemetry();
 
 Q_SIGNALS:
     // For display in the terminal history window.
@@ -43,17 +77,41 @@ Q_SIGNALS:
     void relayError(QString text);
 
 private:
+    void pushCommand(const ShipCommand& command);
+    void checkTelemetry();
+
+    // Simulation thread
+    void run();
+    void step();
+    void applyCommands();
+    void applyCommand(const ShipCommand& command);
+    void applyScript();
+    void publishSnapshot();
+    void recordTelemetry();
+
     PlayerShip* mPlayer;
+    PlayerShipItem* mPlayerItem;
 
     QVector<WorldObject*> mObjects;
     QVector<SignalTrackProcessor*> mTrackProcessors;
     QVector<GuidanceProcessor*> mGuidanceProcessors;
+    QMap<Faction, TrackPicture*> mTrackPictures; // One shared picture per faction
+    GuidanceKernel mGuidanceKernel;
+    OcclusionGrid mOcclusionGrid;
+
+    // The simulation's own copy of the asteroid field, the scene items are only moved by the GUI thread
+    QVector<QPointF> mAsteroidPositions;
+    QVector<qreal> mAsteroidRadii;
+    QPointF mTotalOffset;
+
+    TrackPicture* getTrackPicture(Faction faction);
 
     TacticalScene* mTacticalScene;
     StrategicScene* mStrategicScene;
     ConfigScene* mConfigScene;
 
     void applyPlayerInput();
+    void buildOcclusionGrid();
 
     bool mForwardThrust = false;
     bool mBackwardThrust = false;
@@ -62,4 +120,24 @@ private:
 
     // UID 0 is reserved as a null object indicator
     int mNextUid = 1;
+
+    QThread* mThread = nullptr;
+    std::atomic<bool> mRunning {false};
+    SpscQueue<ShipCommand> mCommands {256};
+    SpscQueue<std::shared_ptr<const CommandScript>> mScripts {4}; // Null stops the running script
+
+    // Simulation thread only
+    std::shared_ptr<const CommandScript> mScript;
+    int mScriptIndex = 0; // Next event to apply
+    uint32_t mScriptStart = 0; // Tick the script started on
+    TripleBuffer<RenderSnapshot> mSnapshots;
+    QPointF mPresentedOffset; // Total offset of the last snapshot applied to the scenes
+
+    FrameRecorder* mRecorder = nullptr; // Only while capturing
+    qint64 mCaptureTime = 0; // Nanoseconds spent capturing on the GUI thread
+
+    TelemetrySink* mTelemetry = nullptr; // Owned by the GUI thread, only while streaming
+    std::atomic<TelemetrySink*> mTelemetryTarget {nullptr}; // The sink the simulation thread records into
+    std::atomic<bool> mTelemetryBusy {false}; // Set while the simulation thread is recording a tick
+    TelemetrySink::Status mTelemetryStatus {TelemetrySink::Status::Opening}; // Last status reported to the terminal
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <QVector>
+
+#include <atomic>
+#include <utility>
+
+#pragma once
+
+
+/**
+ * Bounded lock-free queue between exactly one producer thread and one consumer thread.
+ *
+ * Slots live in a fixed power-of-two ring. The head is only written by the
+ * consumer and the tail only by the producer, each on its own cache line, so
+ * neither side contends with the other unless the queue is full or empty.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @param capacity - Maximum number of queued values, rounded up to a power of two.
+     */
+    explicit SpscQueue(int capacity)
+    {
+        int size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mSlots.resize(size);
+        mMask = uint32_t(size - 1);
+    }
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Producer only. Appends the value to the queue.
+     * @return False (and drops the value) if the queue is full.
+     */
+    bool push(const T& value)
+    {
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) > mMask) {
+            return false;
+        }
+        mSlots[int(tail & mMask)] = value;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Takes the oldest value from the queue.
+     * @return False if the queue is empty.
+     */
+    bool pop(T& value)
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(mSlots[int(head & mMask)]);
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    QVector<T> mSlots;
+    uint32_t mMask;
+    alignas(64) std::atomic<uint32_t> mHead {0}; // Next slot to read
+    alignas(64) std::atomic<uint32_t> mTail {0}; // Next slot to write
+};
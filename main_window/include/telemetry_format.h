@@ -0,0 +1,143 @@
+#include <QtEndian>
+#include <QtMath>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#pragma once
+
+
+/**
+ * Layout of the binary telemetry stream, shared by the sink and the reader.
+ *
+ * A stream is one StreamHeader followed by one record per tick. Each tick is a
+ * TickHeader followed by its object, track, engine and component records, in
+ * that order. Fields are little-endian and packed, the multi-byte fields are
+ * Qt's little-endian integer types so they convert on any host. Values are
+ * quantised to fixed point with the scales in the stream header, saturating at
+ * the limits of the field. A tick holds at most 65535 records of each kind,
+ * any more are left out. Positions are relative to the player, who is always
+ * at the origin.
+ */
+namespace Telemetry
+{
+
+constexpr char sMagic[4] {'B', 'R', 'T', 'M'};
+constexpr uint16_t sVersion {1};
+
+constexpr qreal sPositionScale {16}; // Steps per world unit
+constexpr qreal sVelocityScale {64}; // Steps per world unit per tick
+constexpr qreal sAngleScale {65536 / (2*M_PI)}; // Steps per radian, wraps at a full turn
+constexpr qreal sRatioScale {65535}; // Steps for a thrust ratio of 1
+constexpr qreal sTemperatureScale {4}; // Steps per degree
+
+constexpr int sMaxRecords {std::numeric_limits<uint16_t>::max()}; // Of each kind per tick
+
+#pragma pack(push, 1)
+
+// Qt has no little-endian float, so the bits are stored as an integer
+struct FloatLE
+{
+    quint32_le bits;
+
+    FloatLE& operator=(float value)
+    {
+        quint32 raw;
+        memcpy(&raw, &value, sizeof(raw));
+        bits = raw;
+        return *this;
+    }
+
+    operator float() const
+    {
+        quint32 raw = bits;
+        float value;
+        memcpy(&value, &raw, sizeof(value));
+        return value;
+    }
+};
+
+struct StreamHeader
+{
+    char magic[4];
+    quint16_le version;
+    quint16_le reserved;
+    FloatLE positionScale;
+    FloatLE velocityScale;
+    FloatLE angleScale;
+    FloatLE ratioScale;
+    FloatLE temperatureScale;
+};
+
+struct TickHeader
+{
+    quint32_le tick;
+    quint32_le size; // Bytes of records following this header
+    quint16_le objects;
+    quint16_le tracks;
+    quint16_le engines;
+    quint16_le components;
+};
+
+struct ObjectRecord
+{
+    quint32_le uid;
+    qint32_le x;
+    qint32_le y;
+    qint16_le vx;
+    qint16_le vy;
+    quint16_le heading;
+    uint8_t faction;
+    uint8_t reserved;
+};
+
+struct TrackRecord
+{
+    quint32_le uid;
+    qint32_le x;
+    qint32_le y;
+    qint16_le vx;
+    qint16_le vy;
+    uint8_t faction;
+    uint8_t isCurrent;
+};
+
+// Player ship only
+struct EngineRecord
+{
+    quint16_le component; // Index of the housing component in the tick's component records
+    quint16_le thrustRatio;
+};
+
+// Player ship only
+struct ComponentRecord
+{
+    int8_t x;
+    int8_t y;
+    uint8_t type;
+    uint8_t reserved;
+    quint16_le temperature;
+};
+
+#pragma pack(pop)
+
+/**
+ * Rounds the value in the given scale to the nearest step the field can hold.
+ */
+template <typename T>
+T quantise(qreal value, qreal scale)
+{
+    qreal steps = qRound64(value * scale);
+    return T(qBound(qreal(std::numeric_limits<T>::min()), steps, qreal(std::numeric_limits<T>::max())));
+}
+
+/**
+ * Angles wrap instead of saturating, so any bearing maps onto a full turn.
+ */
+inline uint16_t quantiseAngle(qreal radians)
+{
+    return uint16_t(qRound64(radians * sAngleScale) & 0xffff);
+}
+
+}
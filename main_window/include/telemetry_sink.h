@@ -0,0 +1,113 @@
+#include "include/track_table.h"
+#include "include/component.h"
+#include "include/engine.h"
+#include "include/world_object.h"
+#include "spsc_queue.h"
+#include "telemetry_format.h"
+
+#include <QtWidgets>
+
+#include <atomic>
+#include <memory>
+
+#pragma once
+
+
+/**
+ * Streams per-tick simulation state as compact binary records (see telemetry_format.h).
+ *
+ * The simulation thread fills one of a small pool of reusable buffers per tick
+ * and hands it to a writer thread through a bounded queue, so the tick only
+ * pays for quantising and copying the records. The writer sends each tick to
+ * a file or a local socket and hands the buffer back. If every buffer is still
+ * waiting to be written, the tick is dropped and counted instead.
+ */
+class TelemetrySink
+{
+public:
+    enum class Target
+    {
+        File,
+        Socket, // A local socket (named pipe on Windows) the reader is listening on
+    };
+
+    enum class Status
+    {
+        Opening,
+        Open,
+        Failed, // The target could not be opened or written, ticks are still drained and counted as failed
+    };
+
+    /**
+     * @param target - Path of the file, or name of the local socket.
+     * @param type - Whether the target is a file or a local socket.
+     * @param buffers - Number of ticks that may be waiting on the writer at once.
+     */
+    TelemetrySink(const QString& target, Target type, int buffers = 16);
+    ~TelemetrySink();
+
+    /**
+     * Starts recording a tick into a free buffer. Simulation thread only.
+     * @return False if the tick is dropped because the writer has fallen behind,
+     * in which case nothing may be added until the next tick.
+     */
+    bool beginTick(uint32_t tick);
+
+    // Records must be added in this order, after beginTick()
+    void addObject(const WorldObject& object);
+    void addTrack(const ProcessedTrack& track);
+    void addEngine(const Engine& engine);
+    void addComponent(const Component& component);
+
+    /**
+     * Queues the tick for writing. Simulation thread only.
+     */
+    void endTick();
+
+    /**
+     * Writes every queued tick, then stops the writer thread.
+     */
+    void stop();
+
+    const QString& getTarget() const { return mTarget; }
+    Status getStatus() const { return mStatus.load(std::memory_order_acquire); }
+    // Only set once the status is Failed
+    const QString& getError() const { return mError; }
+    int getRecordedTicks() const { return mRecorded.load(std::memory_order_relaxed); }
+    int getDroppedTicks() const { return mDropped.load(std::memory_order_relaxed); }
+    int getWrittenTicks() const { return mWritten.load(std::memory_order_relaxed); }
+    int getFailedTicks() const { return mFailed.load(std::memory_order_relaxed); }
+
+private:
+    constexpr static int sInitialCapacity {64*1024}; // Bytes per buffer, enough for a few thousand records
+
+    template <typename T>
+    void append(const T& record)
+    {
+        mBuffers[mCurrent].append(reinterpret_cast<const char*>(&record), sizeof(T));
+    }
+
+    std::unique_ptr<QIODevice> open();
+    void write();
+    void fail(const QString& error);
+
+    QString mTarget;
+    Target mType;
+    QVector<QByteArray> mBuffers; // Capacity is kept between ticks, so steady state never allocates
+    SpscQueue<int> mQueued; // Simulation -> writer, indices into mBuffers
+    SpscQueue<int> mFree; // Writer -> simulation
+    QSemaphore mPending; // Counts queued ticks, so the writer can sleep while idle
+    QThread* mThread;
+    std::atomic<bool> mStopping {false};
+    std::atomic<Status> mStatus {Status::Opening};
+    QString mError; // Written by the writer thread before the status becomes Failed
+
+    // Simulation thread only
+    int mCurrent {-1}; // Buffer of the tick being recorded
+    Telemetry::TickHeader mHeader {};
+
+    std::atomic<int> mRecorded {0};
+    std::atomic<int> mDropped {0};
+    std::atomic<int> mWritten {0};
+    std::atomic<int> mFailed {0};
+};
@@ -0,0 +1,63 @@
+#include <atomic>
+
+#pragma once
+
+
+/**
+ * Lock-free triple buffer for handing the latest value from one producer
+ * thread to one consumer thread.
+ *
+ * The producer fills back() and publishes it, the consumer takes the most
+ * recently published value into front(). Neither side ever waits on the
+ * other, a slow consumer simply skips the values it did not get to. Buffers
+ * are reused, so any containers inside T keep their capacity between uses.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * Producer only. Returns the buffer to fill before the next publish().
+     */
+    T& back() { return mBuffers[mBack]; }
+
+    /**
+     * Producer only. Makes the back buffer the latest value, and takes
+     * ownership of a free buffer to fill next.
+     */
+    void publish()
+    {
+        mBack = mMiddle.exchange(mBack | sFresh, std::memory_order_acq_rel) & sIndexMask;
+    }
+
+    /**
+     * Consumer only. Moves the latest published value (if there is a new one) into front().
+     * @return True if front() changed.
+     */
+    bool consume()
+    {
+        if (!(mMiddle.load(std::memory_order_relaxed) & sFresh)) {
+            return false;
+        }
+        mFront = mMiddle.exchange(mFront, std::memory_order_acq_rel) & sIndexMask;
+        return true;
+    }
+
+    /**
+     * Consumer only. Returns the value taken by the last successful consume().
+     */
+    const T& front() const { return mBuffers[mFront]; }
+
+private:
+    constexpr static int sIndexMask {3};
+    constexpr static int sFresh {4}; // Set on the middle index when it holds an unconsumed value
+
+    T mBuffers[3];
+    int mBack {0};
+    std::atomic<int> mMiddle {1};
+    int mFront {2};
+};
@@ -0,0 +1,123 @@
+#include "include/frame_recorder.h"
+
+#include <QBackingStore>
+
+
+FrameRecorder::FrameRecorder(const QString& directory, Format format, int buffers)
+    : mDirectory(directory), mFormat(format), mBuffers(buffers), mQueued(buffers), mFree(buffers)
+{
+    QDir().mkpath(mDirectory);
+    for (int i = 0; i < buffers; i++) {
+        mFree.push(i);
+    }
+    mThread = QThread::create([this]{ encode(); });
+    mThread->start(QThread::LowPriority);
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+bool FrameRecorder::capture(QGraphicsView* left, QGraphicsView* right)
+{
+    int index;
+    if (!mFree.pop(index))
+    {
+        mDropped++;
+        return false;
+    }
+
+    // Buffers are only reallocated if the views are resized, sizes are in device pixels
+    qreal ratio = left->devicePixelRatioF();
+    QSize leftSize = left->viewport()->size() * ratio;
+    QSize rightSize = right->viewport()->size() * ratio;
+    QSize size(leftSize.width() + rightSize.width(), qMax(leftSize.height(), rightSize.height()));
+    QImage& image = mBuffers[index];
+    if (image.size() != size) {
+        image = QImage(size, QImage::Format_RGB32);
+        image.fill(Qt::black);
+    }
+
+    if (!copyPainted(left, image, QPoint(0, 0)) || !copyPainted(right, image, QPoint(leftSize.width(), 0)))
+    {
+        image.fill(Qt::black);
+        QPainter painter(&image);
+        left->render(&painter, QRectF(QPointF(0, 0), leftSize), left->viewport()->rect());
+        right->render(&painter, QRectF(QPointF(leftSize.width(), 0), rightSize), right->viewport()->rect());
+        painter.end();
+    }
+
+    mQueued.push({index, mCaptured++});
+    mPending.release();
+    return true;
+}
+
+bool FrameRecorder::copyPainted(QGraphicsView* view, QImage& image, QPoint at)
+{
+    QWidget* viewport = view->viewport();
+    QBackingStore* store = viewport->window()->backingStore();
+    if (!store || !store->paintDevice() || store->paintDevice()->devType() != QInternal::Image) {
+        return false;
+    }
+    const QImage& source = *static_cast<const QImage*>(store->paintDevice());
+    // Only formats with the same 0xAARRGGBB layout as the buffer can be copied as they are
+    QImage::Format format = source.format();
+    if (format != QImage::Format_RGB32 && format != QImage::Format_ARGB32
+            && format != QImage::Format_ARGB32_Premultiplied) {
+        return false;
+    }
+
+    qreal ratio = source.devicePixelRatio();
+    QRect viewportRect(viewport->mapTo(viewport->window(), QPoint(0, 0)) * ratio, viewport->size() * ratio);
+    QPoint offset = at - viewportRect.topLeft(); // From the source image to the target image
+    QRect rect = viewportRect.intersected(source.rect()).intersected(image.rect().translated(-offset));
+
+    // Both images hold the same 32 bit pixels, so rows are copied as they are
+    for (int y = rect.top(); y <= rect.bottom(); y++)
+    {
+        memcpy(image.scanLine(y + offset.y()) + (rect.left() + offset.x()) * 4,
+               source.constScanLine(y) + rect.left() * 4, size_t(rect.width() * 4));
+    }
+    return true;
+}
+
+void FrameRecorder::stop()
+{
+    if (!mThread) {
+        return;
+    }
+    mStopping = true;
+    mPending.release();
+    mThread->wait();
+    delete mThread;
+    mThread = nullptr;
+}
+
+void FrameRecorder::encode()
+{
+    const char* format = (mFormat == Format::Png) ? "PNG" : "PPM";
+    const char* suffix = (mFormat == Format::Png) ? "png" : "ppm";
+    while (true)
+    {
+        mPending.acquire();
+        Frame frame;
+        if (!mQueued.pop(frame))
+        {
+            // Only woken without a frame to stop, and every earlier frame has been written
+            if (mStopping.load(std::memory_order_acquire)) {
+                return;
+            }
+            continue;
+        }
+
+        QString path = QString("%1/frame_%2.%3").arg(mDirectory).arg(frame.number, 6, 10, QChar('0')).arg(suffix);
+        // Favour speed over size, the sequence is re-encoded for review anyway
+        if (mBuffers.at(frame.buffer).save(path, format, 90)) {
+            mWritten++;
+        } else {
+            mFailed++;
+        }
+        mFree.push(frame.buffer);
+    }
+}
@@ -58,6 +58,13 @@ void MainWindow::closeConfigScreen()
     connect(mTerminal, &Terminal::rotate, mSimulation, &SimulationLoop::rotate);
     connect(mTerminal, &Terminal::toggleTacticalZoom, mTacticalScene, &TacticalScene::toggleZoom);
     connect(mTerminal, &Terminal::toggleMapZoom, mStrategicScene, &StrategicScene::toggleZoom);
+    connect(mTerminal, &Terminal::setMapZoom, mStrategicScene, &StrategicScene::setZoom);
+    connect(mTerminal, &Terminal::startCapture, mSimulation, &SimulationLoop::startCapture);
+    connect(mTerminal, &Terminal::stopCapture, mSimulation, &SimulationLoop::stopCapture);
+    connect(mTerminal, &Terminal::runScript, mSimulation, &SimulationLoop::runScript);
+    connect(mTerminal, &Terminal::stopScript, mSimulation, &SimulationLoop::stopScript);
+    connect(mTerminal, &Terminal::startTelemetry, mSimulation, &SimulationLoop::startTelemetry);
+    connect(mTerminal, &Terminal::stopTelemetry, mSimulation, &SimulationLoop::stopTelemetry);
     mTerminal->show();
     mTerminal->setInputFocus();
 
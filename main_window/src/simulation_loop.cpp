@@ -1,11 +1,16 @@
 #include "include/simulation_loop.h"
 #include "include/radar_sensor.h"
 #include "include/missile.h"
+#include "include/asteroid.h"
+#include "include/missile_batch_item.h"
 
 #include <QtWidgets>
 #include <QFrame>
 #include <QDebug>
 
+#include <chrono>
+#include <thread>
+
 
 SimulationLoop::SimulationLoop(TacticalScene* tacticalScene, StrategicScene* strategicScene, ConfigScene* configScene) : QObject()
 {
@@ -14,6 +19,11 @@ SimulationLoop::SimulationLoop(TacticalScene* tacticalScene, StrategicScene* str
     mConfigScene = configScene;
     initPlayer();
 
+    for (const auto& asteroid : mTacticalScene->getAsteroids()) {
+        mAsteroidPositions << asteroid->getPos();
+        mAsteroidRadii << asteroid->getRadius();
+    }
+
     //DEBUG
     initMissile(200000, 0);
     //initMissile(-40000, -40000);
@@ -24,14 +34,56 @@ SimulationLoop::SimulationLoop(TacticalScene* tacticalScene, StrategicScene* str
 
 void SimulationLoop::start()
 {
-    startTimer(1000/gTargetFramerate);
+    mRunning = true;
+    mThread = QThread::create([this]{ run(); });
+    mThread->start();
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &SimulationLoop::stop);
+
+    // Frames are presented on the GUI thread, independently of the ticks
+    startTimer(1000/gTargetFramerate, Qt::PreciseTimer);
+}
+
+void SimulationLoop::stop()
+{
+    if (mRecorder) {
+        stopCapture();
+    }
+    if (mTelemetry) {
+        stopTelemetry();
+    }
+    if (!mThread) {
+        return;
+    }
+    mRunning = false;
+    mThread->wait();
+    delete mThread;
+    mThread = nullptr;
+}
+
+void SimulationLoop::run()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::microseconds(1000000/gTargetFramerate);
+    auto deadline = Clock::now();
+    while (mRunning.load(std::memory_order_acquire))
+    {
+        step();
+        deadline += period;
+        auto now = Clock::now();
+        if (deadline < now) {
+            // Running behind, carry on from here rather than stepping in a burst to catch up
+            deadline = now;
+        } else {
+            std::this_thread::sleep_until(deadline);
+        }
+    }
 }
 
 void SimulationLoop::initPlayer()
 {
     mPlayer = new PlayerShip(Faction::Blue, mNextUid++);
     mObjects << mPlayer;
-    mTrackProcessors << new SignalTrackProcessor(mPlayer, &mObjects);
+    mTrackProcessors << new SignalTrackProcessor(mPlayer, &mObjects, getTrackPicture(Faction::Blue));
 
     connect(mPlayer, &PlayerShip::displayText, this, &SimulationLoop::receiveInfoFromPlayerShip);
     connect(mPlayer, &PlayerShip::handleAddConfigComponent, mConfigScene, &ConfigScene::drawConfigComponent);
@@ -47,22 +99,160 @@ void SimulationLoop::initPlayer()
 
     mPlayer->handleAddPart(Component::ComponentType::Reactor, {2, 2}, TwoDeg::Up);
 
-    mTacticalScene->addItem(mPlayer->getTacticalGraphicsItem());
+    mPlayerItem = static_cast<PlayerShipItem*>(mPlayer->getTacticalGraphicsItem());
+    mTacticalScene->addContact(mPlayerItem);
 }
 
 void SimulationLoop::initMissile(qreal x, qreal y)
 {
     auto missile = new Missile(Faction::Red, {x, y}, {0, 0}, -M_PI*0.5, mNextUid++);
-    auto processor = new GuidanceProcessor(missile, &mObjects);
+    auto processor = new GuidanceProcessor(missile, &mObjects, getTrackPicture(Faction::Red));
     mGuidanceProcessors << processor;
     mTrackProcessors << processor;
     mObjects << missile;
-    mTacticalScene->addItem(missile->getTacticalGraphicsItem());
+}
+
+TrackPicture* SimulationLoop::getTrackPicture(Faction faction)
+{
+    if (!mTrackPictures.contains(faction)) {
+        mTrackPictures[faction] = new TrackPicture();
+    }
+    return mTrackPictures[faction];
 }
 
 void SimulationLoop::timerEvent(QTimerEvent *event)
+{
+    if (mTelemetry) {
+        checkTelemetry();
+    }
+    if (!mSnapshots.consume()) {
+        return;
+    }
+    const auto& snapshot = mSnapshots.front();
+    QPointF offset = snapshot.totalOffset - mPresentedOffset;
+    mPresentedOffset = snapshot.totalOffset;
+
+    mPlayerItem->setShip(snapshot.playerAtan2, snapshot.playerComponents, snapshot.playerEngines,
+                         snapshot.playerConfigRevision);
+    for (const auto& sensor : snapshot.playerSensors)
+    {
+        if (sensor.isActive) {
+            sensor.item->updateScan(sensor.position, sensor.boreAngle, sensor.scanAngle);
+        } else {
+            sensor.item->updateScan(sensor.position, sensor.boreAngle, false);
+        }
+    }
+
+    auto batch = mTacticalScene->getMissileBatch();
+    while (batch->size() > snapshot.missiles.size()) {
+        batch->removeMissile(batch->size() - 1);
+    }
+    for (int i = 0; i < snapshot.missiles.size(); i++)
+    {
+        const auto& missile = snapshot.missiles[i];
+        if (i < batch->size()) {
+            batch->setMissile(i, missile.position, missile.atan2);
+        } else {
+            batch->addMissile(missile.position, missile.atan2);
+        }
+    }
+
+    mStrategicScene->visualiseTracks(TrackView(snapshot.tracks.constData(), snapshot.tracks.constData() + snapshot.tracks.size()));
+    mTacticalScene->updateItems(offset);
+    mStrategicScene->applyPlayerUpdate(offset, snapshot.playerAtan2, snapshot.playerVel, snapshot.playerAcc);
+
+    // Records the frame painted since the last snapshot, the one applied above is painted next
+    if (mRecorder)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        mRecorder->capture(mTacticalScene->getView(), mStrategicScene->getView());
+        mCaptureTime += timer.nsecsElapsed();
+    }
+}
+
+void SimulationLoop::startCapture(bool png)
+{
+    if (mRecorder) {
+        Q_EMIT relayWarning("CAPTURE ALREADY RUNNING");
+        return;
+    }
+    QString directory = QString("captures/%1").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    mRecorder = new FrameRecorder(directory, png ? FrameRecorder::Format::Png : FrameRecorder::Format::Raw);
+    mCaptureTime = 0;
+    Q_EMIT relayInfo(QString("CAPTURING TO %1").arg(directory));
+}
+
+void SimulationLoop::stopCapture()
+{
+    if (!mRecorder) {
+        Q_EMIT relayWarning("CAPTURE NOT RUNNING");
+        return;
+    }
+    int captured = mRecorder->getCapturedFrames();
+    mRecorder->stop();
+    qreal averageMs = captured ? mCaptureTime * 1e-6 / captured : 0;
+    Q_EMIT relayInfo(QString("CAPTURE STOPPED: %1 FRAMES WRITTEN, %2 DROPPED, %3 FAILED, %4 MS PER FRAME")
+                     .arg(mRecorder->getWrittenFrames()).arg(mRecorder->getDroppedFrames())
+                     .arg(mRecorder->getFailedFrames()).arg(averageMs, 0, 'f', 2));
+    delete mRecorder;
+    mRecorder = nullptr;
+}
+
+void SimulationLoop::startTelemetry(const QString& target, bool isSocket)
+{
+    if (mTelemetry) {
+        Q_EMIT relayWarning("TELEMETRY ALREADY RUNNING");
+        return;
+    }
+    mTelemetry = new TelemetrySink(target, isSocket ? TelemetrySink::Target::Socket : TelemetrySink::Target::File);
+    mTelemetryTarget.store(mTelemetry);
+    mTelemetryStatus = TelemetrySink::Status::Opening;
+    // Confirmed by checkTelemetry() once the writer thread has opened the target
+    Q_EMIT relayInfo(QString("OPENING TELEMETRY TARGET %1").arg(target));
+}
+
+void SimulationLoop::checkTelemetry()
+{
+    auto status = mTelemetry->getStatus();
+    if (status == mTelemetryStatus) {
+        return;
+    }
+    mTelemetryStatus = status;
+    if (status == TelemetrySink::Status::Open)
+    {
+        Q_EMIT relayInfo(QString("STREAMING TELEMETRY TO %1").arg(mTelemetry->getTarget()));
+    }
+    else if (status == TelemetrySink::Status::Failed)
+    {
+        Q_EMIT relayError(QString("TELEMETRY FAILED ON %1: %2").arg(mTelemetry->getTarget(), mTelemetry->getError()));
+        stopTelemetry();
+    }
+}
+
+void SimulationLoop::stopTelemetry()
+{
+    if (!mTelemetry) {
+        Q_EMIT relayWarning("TELEMETRY NOT RUNNING");
+        return;
+    }
+    // Once the simulation thread is seen outside recordTelemetry(), it cannot see the sink again
+    mTelemetryTarget.store(nullptr);
+    while (mTelemetryBusy.load()) {
+        std::this_thread::yield();
+    }
+    mTelemetry->stop();
+    Q_EMIT relayInfo(QString("TELEMETRY STOPPED: %1 TICKS WRITTEN, %2 DROPPED, %3 FAILED")
+                     .arg(mTelemetry->getWrittenTicks()).arg(mTelemetry->getDroppedTicks())
+                     .arg(mTelemetry->getFailedTicks()));
+    delete mTelemetry;
+    mTelemetry = nullptr;
+}
+
+void SimulationLoop::step()
 {
     // The player ship is always at the origin, the world moves instead
+    applyCommands();
     applyPlayerInput();
     Vector playerVelocity = mPlayer->getVelVector();
     playerVelocity.flip();
@@ -72,27 +262,106 @@ void SimulationLoop::timerEvent(QTimerEvent *event)
         object->updatePosition(playerOffset);
         object->updateSensors();
     }
+    for (auto& position : mAsteroidPositions) {
+        position += playerOffset;
+    }
+    mTotalOffset += playerOffset;
 
-    // Update sensors
+    // Update sensors, then fuse each faction's detections once
+    buildOcclusionGrid();
     for (const auto& processor : mTrackProcessors) {
-        processor->computeTracks();
+        processor->computeDetections(mOcclusionGrid);
+    }
+    for (const auto& picture : mTrackPictures) {
+        picture->update();
+    }
 
-        if (processor->getParent() == mPlayer) {
-            auto tracks = processor->getTracks();
-            mStrategicScene->visualiseTracks(tracks);
-        }
+    // Guide every missile in one batch
+    mGuidanceKernel.clear();
+    for (const auto& processor : mGuidanceProcessors) {
+        processor->submitGuidance(mGuidanceKernel);
     }
+    mGuidanceKernel.compute();
     for (const auto& processor : mGuidanceProcessors) {
-        processor->guideToMostValidTarget();
+        processor->applyGuidance(mGuidanceKernel);
     }
 
-    mTacticalScene->updateItems(playerOffset);
-    mStrategicScene->applyPlayerUpdate(playerOffset, mPlayer->getAtan2(), mPlayer->getVelVector(),
-                                       mPlayer->getAccVector());
-
+    publishSnapshot();
+    recordTelemetry();
     gTimeStamp++;
 }
 
+void SimulationLoop::publishSnapshot()
+{
+    auto& snapshot = mSnapshots.back();
+    snapshot.timestamp = gTimeStamp;
+    snapshot.totalOffset = mTotalOffset;
+
+    snapshot.playerAtan2 = mPlayer->getAtan2();
+    snapshot.playerVel = mPlayer->getVelVector();
+    snapshot.playerAcc = mPlayer->getAccVector();
+    // Implicitly shared, the simulation detaches its own copy on its next write
+    snapshot.playerComponents = mPlayer->getComponents();
+    snapshot.playerEngines = mPlayer->getEngines();
+    snapshot.playerConfigRevision = mPlayer->getConfigRevision();
+    snapshot.playerSensors.clear();
+    for (const auto& sensor : mPlayer->getSensors())
+    {
+        snapshot.playerSensors.append({sensor->getItem(), mPlayer->getPoint(),
+                                       mPlayer->getAtan2() + sensor->getBoreAngleOffset(),
+                                       sensor->getScanPosition(), sensor->isActive()});
+    }
+
+    snapshot.missiles.clear();
+    for (const auto& processor : mGuidanceProcessors)
+    {
+        auto missile = processor->getParent();
+        snapshot.missiles.append({missile->getPoint(), missile->getAtan2()()});
+    }
+
+    TrackView tracks = getTrackPicture(Faction::Blue)->getTracks();
+    snapshot.tracks.resize(tracks.size());
+    std::copy(tracks.begin(), tracks.end(), snapshot.tracks.begin());
+
+    mSnapshots.publish();
+}
+
+void SimulationLoop::recordTelemetry()
+{
+    // Sequentially consistent, paired with stopTelemetry() so the sink is never deleted mid tick
+    mTelemetryBusy.store(true);
+    TelemetrySink* sink = mTelemetryTarget.load();
+    if (sink && sink->beginTick(gTimeStamp))
+    {
+        for (const auto& object : mObjects) {
+            sink->addObject(*object);
+        }
+        for (const auto& track : getTrackPicture(Faction::Blue)->getTracks()) {
+            sink->addTrack(track);
+        }
+        for (const auto& engine : mPlayer->getEngines()) {
+            sink->addEngine(engine);
+        }
+        for (const auto& component : mPlayer->getComponents()) {
+            sink->addComponent(component);
+        }
+        sink->endTick();
+    }
+    mTelemetryBusy.store(false, std::memory_order_release);
+}
+
+void SimulationLoop::buildOcclusionGrid()
+{
+    mOcclusionGrid.clear();
+    for (int i = 0; i < mAsteroidPositions.size(); i++) {
+        mOcclusionGrid.add(mAsteroidPositions[i], mAsteroidRadii[i]);
+    }
+    for (const auto& object : mObjects) {
+        mOcclusionGrid.add(object->getPoint(), object->getRadius(), object->getId());
+    }
+    mOcclusionGrid.build();
+}
+
 void SimulationLoop::applyPlayerInput()
 {
     mPlayer->resetMovement();
@@ -104,25 +373,96 @@ void SimulationLoop::applyPlayerInput()
     mPlayer->update();
 }
 
-void SimulationLoop::setThrust(TwoDeg direction, bool isActive)
+void SimulationLoop::applyCommands()
 {
-    switch (direction)
+    ShipCommand command;
+    while (mCommands.pop(command)) {
+        applyCommand(command);
+    }
+
+    std::shared_ptr<const CommandScript> script;
+    while (mScripts.pop(script))
     {
-        case TwoDeg::Up:
-            mForwardThrust = isActive;
-            break;
-        case TwoDeg::Down:
-            mBackwardThrust = isActive;
-            break;
-        case TwoDeg::Left:
-            mLeftThrust = isActive;
+        if (!script && mScript) {
+            Q_EMIT relayInfo("SCRIPT STOPPED");
+        }
+        mScript = std::move(script);
+        mScriptIndex = 0;
+        mScriptStart = gTimeStamp;
+    }
+    if (mScript) {
+        applyScript();
+    }
+}
+
+void SimulationLoop::applyScript()
+{
+    uint32_t tick = gTimeStamp - mScriptStart;
+    while (mScriptIndex < mScript->size() && mScript->at(mScriptIndex).tick <= tick) {
+        applyCommand(mScript->at(mScriptIndex++).command);
+    }
+    if (mScriptIndex == mScript->size())
+    {
+        mScript.reset();
+        Q_EMIT relayInfo("SCRIPT COMPLETE");
+    }
+}
+
+void SimulationLoop::applyCommand(const ShipCommand& command)
+{
+    switch (command.type)
+    {
+        case ShipCommand::Type::Thrust:
+            switch (command.direction)
+            {
+                case TwoDeg::Up:
+                    mForwardThrust = command.isActive;
+                    break;
+                case TwoDeg::Down:
+                    mBackwardThrust = command.isActive;
+                    break;
+                case TwoDeg::Left:
+                    mLeftThrust = command.isActive;
+                    break;
+                case TwoDeg::Right:
+                    mRightThrust = command.isActive;
+                    break;
+            }
             break;
-        case TwoDeg::Right:
-            mRightThrust = isActive;
+        case ShipCommand::Type::Rotate:
+            mPlayer->rotate(qreal(command.degrees));
             break;
     }
 }
 
+void SimulationLoop::pushCommand(const ShipCommand& command)
+{
+    if (!mCommands.push(command)) {
+        Q_EMIT relayWarning("Input dropped, the simulation is not keeping up");
+    }
+}
+
+void SimulationLoop::runScript(std::shared_ptr<const CommandScript> script)
+{
+    if (!mScripts.push(script)) {
+        Q_EMIT relayWarning("Script dropped, the simulation is not keeping up");
+    }
+}
+
+void SimulationLoop::stopScript()
+{
+    runScript(nullptr);
+}
+
+void SimulationLoop::setThrust(TwoDeg direction, bool isActive)
+{
+    ShipCommand command;
+    command.type = ShipCommand::Type::Thrust;
+    command.direction = direction;
+    command.isActive = isActive;
+    pushCommand(command);
+}
+
 void SimulationLoop::addSensors(QVector<std::shared_ptr<Sensor>> sensors)
 {
     for (const auto& sensor : sensors) {
@@ -139,7 +479,10 @@ void SimulationLoop::clearSensors(QVector<std::shared_ptr<Sensor>> sensors)
 
 void SimulationLoop::rotate(int degrees)
 {
-    mPlayer->rotate(qreal(degrees));
+    ShipCommand command;
+    command.type = ShipCommand::Type::Rotate;
+    command.degrees = degrees;
+    pushCommand(command);
 }
 
 void SimulationLoop::receiveInfoFromPlayerShip(const QString& text)
@@ -0,0 +1,219 @@
+#include "include/telemetry_sink.h"
+
+#include <QLocalSocket>
+
+
+TelemetrySink::TelemetrySink(const QString& target, Target type, int buffers)
+    : mTarget(target), mType(type), mBuffers(buffers), mQueued(buffers), mFree(buffers)
+{
+    for (int i = 0; i < buffers; i++)
+    {
+        // Reserving also stops resize(0) from releasing the storage between ticks
+        mBuffers[i].reserve(sInitialCapacity);
+        mFree.push(i);
+    }
+    // The device is opened by the writer thread, local sockets can only be used by the thread that made them
+    mThread = QThread::create([this]{ write(); });
+    mThread->start(QThread::LowPriority);
+}
+
+TelemetrySink::~TelemetrySink()
+{
+    stop();
+}
+
+bool TelemetrySink::beginTick(uint32_t tick)
+{
+    if (!mFree.pop(mCurrent))
+    {
+        mCurrent = -1;
+        mDropped++;
+        return false;
+    }
+    mHeader = {};
+    mHeader.tick = tick;
+
+    // The header is written again with the counts once the tick is complete
+    mBuffers[mCurrent].resize(0);
+    append(mHeader);
+    return true;
+}
+
+void TelemetrySink::addObject(const WorldObject& object)
+{
+    Q_ASSERT(mHeader.tracks == 0 && mHeader.engines == 0 && mHeader.components == 0);
+    if (mHeader.objects == Telemetry::sMaxRecords) {
+        return;
+    }
+    Telemetry::ObjectRecord record {};
+    record.uid = uint32_t(object.getId());
+    record.x = Telemetry::quantise<int32_t>(object.getPoint().x(), Telemetry::sPositionScale);
+    record.y = Telemetry::quantise<int32_t>(object.getPoint().y(), Telemetry::sPositionScale);
+    record.vx = Telemetry::quantise<int16_t>(object.getVelVector().x(), Telemetry::sVelocityScale);
+    record.vy = Telemetry::quantise<int16_t>(object.getVelVector().y(), Telemetry::sVelocityScale);
+    record.heading = Telemetry::quantiseAngle(object.getAtan2()());
+    record.faction = uint8_t(object.getFaction());
+    append(record);
+    mHeader.objects++;
+}
+
+void TelemetrySink::addTrack(const ProcessedTrack& track)
+{
+    Q_ASSERT(mHeader.engines == 0 && mHeader.components == 0);
+    if (mHeader.tracks == Telemetry::sMaxRecords) {
+        return;
+    }
+    Telemetry::TrackRecord record {};
+    record.uid = track.uid;
+    record.x = Telemetry::quantise<int32_t>(track.position.x(), Telemetry::sPositionScale);
+    record.y = Telemetry::quantise<int32_t>(track.position.y(), Telemetry::sPositionScale);
+    record.vx = Telemetry::quantise<int16_t>(track.vel.x(), Telemetry::sVelocityScale);
+    record.vy = Telemetry::quantise<int16_t>(track.vel.y(), Telemetry::sVelocityScale);
+    record.faction = uint8_t(track.faction);
+    record.isCurrent = track.isCurrent;
+    append(record);
+    mHeader.tracks++;
+}
+
+void TelemetrySink::addEngine(const Engine& engine)
+{
+    Q_ASSERT(mHeader.components == 0);
+    if (mHeader.engines == Telemetry::sMaxRecords) {
+        return;
+    }
+    Telemetry::EngineRecord record {};
+    record.component = uint16_t(engine.getComponentIndex());
+    record.thrustRatio = Telemetry::quantise<uint16_t>(engine.getThrustRatio(), Telemetry::sRatioScale);
+    append(record);
+    mHeader.engines++;
+}
+
+void TelemetrySink::addComponent(const Component& component)
+{
+    if (mHeader.components == Telemetry::sMaxRecords) {
+        return;
+    }
+    Telemetry::ComponentRecord record {};
+    record.x = int8_t(component.x());
+    record.y = int8_t(component.y());
+    record.type = uint8_t(component.getType());
+    record.temperature = Telemetry::quantise<uint16_t>(component.getTemperature(), Telemetry::sTemperatureScale);
+    append(record);
+    mHeader.components++;
+}
+
+void TelemetrySink::endTick()
+{
+    QByteArray& buffer = mBuffers[mCurrent];
+    mHeader.size = uint32_t(buffer.size() - int(sizeof(Telemetry::TickHeader)));
+    memcpy(buffer.data(), &mHeader, sizeof(Telemetry::TickHeader));
+
+    mQueued.push(mCurrent);
+    mPending.release();
+    mCurrent = -1;
+    mRecorded++;
+}
+
+void TelemetrySink::stop()
+{
+    if (!mThread) {
+        return;
+    }
+    mStopping = true;
+    mPending.release();
+    mThread->wait();
+    delete mThread;
+    mThread = nullptr;
+}
+
+std::unique_ptr<QIODevice> TelemetrySink::open()
+{
+    if (mType == Target::Socket)
+    {
+        auto socket = std::make_unique<QLocalSocket>();
+        socket->connectToServer(mTarget, QIODevice::WriteOnly);
+        if (!socket->waitForConnected(1000))
+        {
+            fail(socket->errorString());
+            return nullptr;
+        }
+        return socket;
+    }
+    auto file = std::make_unique<QFile>(mTarget);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        fail(file->errorString());
+        return nullptr;
+    }
+    return file;
+}
+
+void TelemetrySink::fail(const QString& error)
+{
+    if (mStatus.load(std::memory_order_relaxed) == Status::Failed) {
+        return;
+    }
+    mError = error;
+    mStatus.store(Status::Failed, std::memory_order_release);
+}
+
+void TelemetrySink::write()
+{
+    auto device = open();
+    if (device)
+    {
+        Telemetry::StreamHeader header {};
+        memcpy(header.magic, Telemetry::sMagic, sizeof(header.magic));
+        header.version = Telemetry::sVersion;
+        header.positionScale = float(Telemetry::sPositionScale);
+        header.velocityScale = float(Telemetry::sVelocityScale);
+        header.angleScale = float(Telemetry::sAngleScale);
+        header.ratioScale = float(Telemetry::sRatioScale);
+        header.temperatureScale = float(Telemetry::sTemperatureScale);
+        if (device->write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header))
+        {
+            mStatus.store(Status::Open, std::memory_order_release);
+        }
+        else
+        {
+            fail(device->errorString());
+            device.reset();
+        }
+    }
+
+    while (true)
+    {
+        mPending.acquire();
+        int index;
+        if (!mQueued.pop(index))
+        {
+            // Only woken without a tick to stop, and every earlier tick has been written
+            if (mStopping.load(std::memory_order_acquire)) {
+                break;
+            }
+            continue;
+        }
+
+        // Ticks are still drained once the target has failed, so the simulation never runs out of buffers
+        const QByteArray& buffer = mBuffers.at(index);
+        if (device && device->write(buffer) == buffer.size())
+        {
+            // There is no event loop on this thread, so sockets are flushed by waiting
+            while (device->bytesToWrite() > 0 && device->waitForBytesWritten(1000)) {}
+            mWritten++;
+        }
+        else
+        {
+            if (device) {
+                fail(device->errorString());
+            }
+            device.reset();
+            mFailed++;
+        }
+        mFree.push(index);
+    }
+
+    if (device) {
+        device->close();
+    }
+}
@@ -0,0 +1,69 @@
+#include <QtWidgets>
+
+#include <cstring>
+
+#pragma once
+
+
+/**
+ * Radar range-equation detection model.
+ *
+ * The received power from a target is Pt * G * sigma / R^4, and the detection
+ * probability for a given signal-to-noise ratio is Pfa^(1 / (1 + SNR)) (Swerling I).
+ * Both only depend on R^2 / sqrt(sigma), the "effective squared range". The power
+ * is cheap to compute directly. The probability is tabulated once per octave of
+ * the effective squared range, so every range has the same relative resolution.
+ * A bin is found from the exponent and leading mantissa bits of the float, so a
+ * lookup needs no log.
+ */
+class DetectionModel
+{
+public:
+    /**
+     * Returns a (shared) model for the given transmit power and noise floor.
+     * @param txPower - Total transmit power.
+     * @param noiseFloor - Receiver noise floor, zero or less for a noiseless receiver.
+     */
+    static std::shared_ptr<const DetectionModel> get(qreal txPower, qreal noiseFloor);
+
+    /**
+     * Returns the effective squared range of a target.
+     * @param rangeSquared - The squared distance to the target.
+     * @param rootCrossSectionInv - The reciprocal of the square root of the target cross-section.
+     */
+    static float effectiveRangeSquared(qreal rangeSquared, qreal rootCrossSectionInv)
+    {
+        return float(rangeSquared * rootCrossSectionInv);
+    }
+
+    /**
+     * Evaluates a batch of candidates.
+     * @param effectiveRangeSq - Per candidate, the effective squared range.
+     * @param probability - Output, per candidate, the probability of detection.
+     * @param power - Output, per candidate, the received power.
+     */
+    void evaluate(const QVector<float>& effectiveRangeSq, QVector<float>& probability, QVector<float>& power) const;
+
+    constexpr static qreal sRadarGain {1e20}; // Antenna gain, wavelength and 4pi terms combined
+    constexpr static qreal sFalseAlarmProbability {1e-6};
+    constexpr static qreal sMinProbability {1e-4}; // Beyond this the table ends and detection is impossible
+    constexpr static int sTableOctaves {27}; // About 1e-8 of the table's end, closer is certain detection
+    constexpr static int sMantissaBits {6}; // Leading mantissa bits per bin, so 64 bins per octave
+    constexpr static int sTableSize {sTableOctaves << sMantissaBits};
+
+private:
+    DetectionModel(qreal txPower, qreal noiseFloor);
+
+    static quint32 getBinKey(float rangeSq)
+    {
+        quint32 bits;
+        memcpy(&bits, &rangeSq, sizeof(bits));
+        return bits >> (23 - sMantissaBits);
+    }
+
+    bool mNoiseless;
+    float mMaxRangeSq; // Effective squared range at which the table ends
+    quint32 mFirstBin; // Bin key (float bits shifted down to the exponent and leading mantissa) of the table start
+    qreal mPowerScale; // Pt * G
+    QVector<float> mProbabilityTable;
+};
@@ -0,0 +1,63 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Batched (augmented) proportional navigation over every guided missile.
+ *
+ * The lateral acceleration demanded is N * Vc * dLOS/dt, plus N/2 of the target's
+ * acceleration normal to the line of sight when augmented. Missiles can only thrust
+ * along their heading, so the remaining thrust is spent closing down the line of
+ * sight and the resulting direction is the commanded heading. Inputs and outputs
+ * are held as structure-of-arrays and computed in a single pass.
+ */
+class GuidanceKernel
+{
+public:
+    /**
+     * @param navigationGain - The navigation constant N, typically 3 to 5.
+     * @param augmented - True to also lead the target's acceleration (APN).
+     */
+    explicit GuidanceKernel(qreal navigationGain = 4.0, bool augmented = true);
+
+    /**
+     * Removes every missile from the batch.
+     */
+    void clear();
+
+    /**
+     * Adds a missile to the batch.
+     * @param relPos - Position of the target relative to the missile.
+     * @param relVel - Velocity of the target relative to the missile.
+     * @param targetAcc - Acceleration of the target.
+     * @param maxAcc - Acceleration the missile can produce along its heading.
+     * @return The index of the missile within the batch.
+     */
+    int add(QPointF relPos, QPointF relVel, QPointF targetAcc, qreal maxAcc);
+
+    /**
+     * Computes the commanded heading of every missile in the batch.
+     */
+    void compute();
+
+    /**
+     * Returns the commanded heading (rads), valid after compute().
+     */
+    qreal getBearing(int index) const { return mBearing[index]; }
+
+    int size() const { return mRelPosX.size(); }
+
+private:
+    float mNavigationGain;
+    float mAugmentedGain;
+
+    QVector<float> mRelPosX;
+    QVector<float> mRelPosY;
+    QVector<float> mRelVelX;
+    QVector<float> mRelVelY;
+    QVector<float> mTargetAccX;
+    QVector<float> mTargetAccY;
+    QVector<float> mMaxAcc;
+    QVector<qreal> mBearing;
+};
@@ -1,4 +1,6 @@
 #include "signal_track_processor.h"
+#include "include/guidance_kernel.h"
+#include "include/indexed_heap.h"
 
 
 /*
@@ -7,17 +9,53 @@
 class GuidanceProcessor : public SignalTrackProcessor
 {
 public:
-    GuidanceProcessor(WorldObject* parent, QVector<WorldObject*>* worldObjects)
-    : SignalTrackProcessor(parent, worldObjects) {}
+    /**
+     * How the tracks are ranked when selecting a target.
+     */
+    enum class TargetScore
+    {
+        Recency, // Most recently detected
+        Range, // Nearest
+        ClosureRate, // Fastest closing
+        Threat // Shortest time to intercept, i.e. closure rate over range
+    };
+
+    GuidanceProcessor(WorldObject* parent, QVector<WorldObject*>* worldObjects, TrackPicture* picture,
+                      TargetScore targetScore = TargetScore::Recency)
+    : SignalTrackProcessor(parent, worldObjects, picture), mTargetScore(targetScore) {}
     ~GuidanceProcessor() = default;
 
     /**
-     * Commands the parent object to rotate towards the most valid
-     * target track. If there is no valid track no rotate command is given.
+     * Selects the most valid target track and adds the engagement to the guidance batch.
+     * If there is no valid track nothing is added.
+     * @param kernel - The batch shared by every guided missile this tick.
      */
-    void guideToMostValidTarget();
+    void submitGuidance(GuidanceKernel& kernel);
+
+    /**
+     * Commands the parent object to rotate to the heading computed for it by the batch.
+     * @param kernel - The batch, after GuidanceKernel::compute().
+     */
+    void applyGuidance(const GuidanceKernel& kernel);
 
 private:
-    uint32_t mLastTarget {0};
-    Bearing mLastValidBearing {0};
-};
\ No newline at end of file
+    /**
+     * Brings the target heap in step with the track picture.
+     * @param position - Position of the parent.
+     * @param velocity - Velocity of the parent, in the world frame.
+     */
+    void updateTargetScores(QPointF position, QPointF velocity);
+
+    /**
+     * Returns the score of the given track, higher is a more valid target.
+     */
+    float computeScore(const ProcessedTrack& track, QPointF position, QPointF velocity) const;
+
+    TargetScore mTargetScore;
+    IndexedHeap mTargets; // Track uids keyed by score
+    bool mIsScored {false}; // Whether every track in the picture has been scored once
+
+    int mKernelIndex {-1}; // Index in this tick's guidance batch, -1 if not guiding
+    QPointF mLastPosition;
+    bool mHasLastPosition {false};
+};
@@ -1,5 +1,9 @@
 #include "include/component.h"
 
+#include <array>
+
+#pragma once
+
 
 /**
  * Model for simulating the flow of heat between components
@@ -7,35 +11,28 @@
 class HeatFlow
 {
 public:
-    explicit HeatFlow(QMap<QPair<int, int>, std::shared_ptr<Component>>& componentMap) : mComponentMap(componentMap) { ; }
+    explicit HeatFlow(QVector<Component>& components) : mComponents(components) { ; }
 
     /**
-     * Takes the given coordinate->component map, and applies the
-     * per-component temperature differentials based on a simple
-     * model of heat flow.
+     * Rebuilds the per-component neighbour table from the given
+     * coordinate->component index map. Must be called whenever the
+     * ship layout changes.
+     * @param componentIndex - Map of grid coordinate to index into the components.
      */
-    void compute();
-
-private:
+    void updateNeighbours(const QMap<QPair<int, int>, int>& componentIndex);
 
     /**
-     * Computes the delta between the src component and the neighbouring
-     * component at x,y (if extant).
-     * @param src - The component.
-     * @param x - The x coordinate to check for a neighbouring component.
-     * @param y - The y coordinate to check for a neighbouring component.
+     * Applies the per-component temperature differentials based on
+     * a simple model of heat flow.
      */
-    void computeHeatFlow(const std::shared_ptr<Component>& src, int x, int y);
+    void compute();
 
-    /**
-     * Reduce the temperature of a component by 10% for every unconnected face.
-     * @param src - The component.
-     * @param x - The x coordinate to check for a neighbouring component.
-     * @param y - The y coordinate to check for a neighbouring component.
-     */
-    void computeHeatExhaust(const std::shared_ptr<Component>& src, int x, int y);
+private:
+    // Index of the neighbouring component on each face, -1 for an unconnected face
+    typedef std::array<int, 4> Neighbours;
 
-    QMap<QPair<int, int>, std::shared_ptr<Component>>& mComponentMap;
-    QMap<std::shared_ptr<Component>, int> mValidNeighbours;
-    QMap<std::shared_ptr<Component>, qreal> mTempDeltas;
-};
\ No newline at end of file
+    QVector<Component>& mComponents;
+    QVector<Neighbours> mNeighbours;
+    QVector<int> mValidNeighbours;
+    QVector<qreal> mTempDeltas;
+};
@@ -0,0 +1,49 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Binary max-heap of scores keyed by uid, with an index from each uid to its
+ * position in the heap so a score can be changed or removed in O(log n).
+ */
+class IndexedHeap
+{
+public:
+    IndexedHeap() = default;
+    ~IndexedHeap() = default;
+
+    /**
+     * Sets the score for the given uid, inserting it if not already present.
+     */
+    void update(uint32_t uid, float score);
+
+    /**
+     * Removes the given uid (if present).
+     */
+    void remove(uint32_t uid);
+
+    bool contains(uint32_t uid) const { return mPositions.contains(uid); }
+    bool empty() const { return mHeap.empty(); }
+    int size() const { return mHeap.size(); }
+
+    /**
+     * Returns the uid with the highest score, the heap must not be empty.
+     */
+    uint32_t top() const { return mHeap[0].uid; }
+    float topScore() const { return mHeap[0].score; }
+
+private:
+    struct Entry
+    {
+        uint32_t uid;
+        float score;
+    };
+
+    void siftUp(int i);
+    void siftDown(int i);
+    void place(int i, const Entry& entry);
+
+    QVector<Entry> mHeap;
+    QHash<uint32_t, int> mPositions;
+};
@@ -0,0 +1,97 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Uniform grid of circular occluders (asteroids, ships) for line-of-sight tests.
+ *
+ * The grid only spans the bounds of the occluders, so rays are first clipped to
+ * those bounds and then walked cell by cell (Amanatides & Woo), testing only the
+ * occluders registered in the cells the ray passes through. Rebuilt once per tick.
+ */
+class OcclusionGrid
+{
+public:
+    /**
+     * @param cellSize - Preferred edge length of a cell, in world units. Grown if
+     *                   the occluders are spread so far apart it would need too many cells.
+     */
+    explicit OcclusionGrid(qreal cellSize = 500);
+
+    /**
+     * Removes every occluder.
+     */
+    void clear();
+
+    /**
+     * Adds an occluder, visible from the next build().
+     * @param centre - Centre of the occluder.
+     * @param radius - Radius of the occluder, occluders without a radius are ignored.
+     * @param uid - The world object the occluder belongs to, 0 if it is not a world object.
+     */
+    void add(QPointF centre, qreal radius, uint32_t uid = 0);
+
+    /**
+     * Buckets the occluders into the grid.
+     */
+    void build();
+
+    /**
+     * Returns true if the segment between the two points passes through any occluder.
+     * @param from - Start of the line of sight, e.g. the sensor platform.
+     * @param to - End of the line of sight, e.g. the target.
+     * @param fromUid - Uid of the world object at the start, which cannot occlude itself.
+     * @param toUid - Uid of the world object at the end, which cannot occlude itself.
+     */
+    bool isOccluded(QPointF from, QPointF to, uint32_t fromUid, uint32_t toUid) const;
+
+    /**
+     * Tests the lines of sight from one point to a batch of targets.
+     * @param from - Start of every line of sight.
+     * @param fromUid - Uid of the world object at the start.
+     * @param targets - End of each line of sight.
+     * @param targetUids - Uid of the world object at the end of each line of sight.
+     * @param occluded - Output, per target, true if its line of sight is blocked.
+     */
+    void computeOcclusion(QPointF from, uint32_t fromUid, const QVector<QPointF>& targets,
+                          const QVector<uint32_t>& targetUids, QVector<bool>& occluded) const;
+
+    bool empty() const { return mOccluders.empty(); }
+
+private:
+    struct Occluder
+    {
+        float x;
+        float y;
+        float radiusSq;
+        uint32_t uid;
+    };
+
+    int cellX(qreal x) const { return qBound(0, int((x - mMinX) * mCellScale), mCellsX - 1); }
+    int cellY(qreal y) const { return qBound(0, int((y - mMinY) * mCellScale), mCellsY - 1); }
+
+    /**
+     * Returns true if the segment passes through any occluder in the given cell.
+     */
+    bool testCell(int cell, QPointF from, QPointF delta, qreal lengthSqInv, uint32_t fromUid, uint32_t toUid) const;
+
+    constexpr static int sMaxCells {1 << 16};
+
+    qreal mPreferredCellSize;
+
+    QVector<Occluder> mOccluders;
+    QVector<float> mRadii;
+
+    // Grid, valid after build()
+    qreal mMinX {0};
+    qreal mMinY {0};
+    qreal mMaxX {0};
+    qreal mMaxY {0};
+    qreal mCellSize {0};
+    qreal mCellScale {0}; // 1 / mCellSize
+    int mCellsX {0};
+    int mCellsY {0};
+    QVector<int> mCellStart; // Per cell, offset into mCellOccluders (CSR)
+    QVector<int> mCellOccluders;
+};
@@ -9,7 +9,7 @@ class RadarSensor : public Sensor
 public:
     RadarSensor(WorldObject* parent, qreal boreOffset, qreal cwStart, qreal cwEnd, qreal scanFOV = M_PI*0.1, qreal scanSpeed = 0.01)
             : Sensor(Sensor::Radiation::Radio, Sensor::Radiation::Radio,
-                     100, 0,
+                     100, 2,
                      boreOffset,
                      cwStart,
                      cwEnd,
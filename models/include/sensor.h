@@ -1,4 +1,5 @@
 #include "include/sensor_fov_item.h"
+#include "include/detection_model.h"
 
 #include <QtWidgets>
 
@@ -27,15 +28,19 @@ public:
                 }
                 mScanPosition = 0.5*(mRightFOVLimit - mLeftFOVLimit);
                 mItem = new SensorFOV(mLeftFOVLimit, mRightFOVLimit, mScanFOV);
+                mDetectionModel = DetectionModel::get(mTxPower, mRxPower);
             }
     ~Sensor() = default;
 
-    QGraphicsItem* getItem() { return mItem; }
+    /**
+     * Returns the FOV item, which only the GUI thread may touch.
+     */
+    SensorFOV* getItem() { return mItem; }
 
     /**
-     * Update the scan angle and the associated graphics item (if any).
+     * Update the scan angle. The graphics item is updated separately from a render snapshot.
      */
-    void update(QPointF parentPosition, Bearing parentAngle);
+    void update();
 
     /**
      * Determines if the given angle is inside the sensor FOV.
@@ -45,6 +50,26 @@ public:
      */
     bool withinFOV(qreal offBoreAngle) const;
 
+    /**
+     * Returns the centre of the current scan window, relative to the longitudinal axis of the parent.
+     */
+    qreal getScanCentre() const { return mBoreAngleOffset + mScanPosition; }
+
+    /**
+     * Returns half of the angular width of the current scan window.
+     */
+    qreal getScanHalfWidth() const { return mScanFOV; }
+
+    qreal getBoreAngleOffset() const { return mBoreAngleOffset; }
+    qreal getScanPosition() const { return mScanPosition; }
+
+    bool isActive() const { return mIsActive; }
+
+    /**
+     * Returns the range-equation model shared by every sensor with the same powers.
+     */
+    const DetectionModel& getDetectionModel() const { return *mDetectionModel; }
+
 protected:
     Radiation mRadTx; // The radiation the sensor emits
     Radiation mRadRx; // The radiation the sensor receives
@@ -64,4 +89,5 @@ protected:
     bool mSweepEnabled = true;
 
     SensorFOV* mItem;
+    std::shared_ptr<const DetectionModel> mDetectionModel;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Objects sorted by their bearing relative to a platform, so the objects inside
+ * a sensor's scan window can be found with a binary search rather than testing
+ * every object against every sensor.
+ */
+class SensorCoverageIndex
+{
+public:
+    /**
+     * Empties the index, ready for the objects of the next tick.
+     */
+    void clear() { mEntries.clear(); }
+
+    /**
+     * Adds an object to the index. build() must be called before querying.
+     * @param offBoreAngle - Angle of the object relative to the longitudinal axis of the platform.
+     * @param id - Identifier returned by queries for this object.
+     */
+    void add(qreal offBoreAngle, int id);
+
+    /**
+     * Sorts the objects by bearing.
+     */
+    void build();
+
+    /**
+     * Appends the ids of every object within the given arc.
+     * @param centre - The centre of the arc, relative to the longitudinal axis of the platform.
+     * @param halfWidth - Half of the angular width of the arc.
+     * @param ids - Output, the ids of the objects within the arc.
+     */
+    void query(qreal centre, qreal halfWidth, QVector<int>& ids) const;
+
+private:
+    /**
+     * Wraps the given angle into [-pi, pi).
+     */
+    static qreal wrap(qreal angle);
+
+    void queryRange(qreal start, qreal end, QVector<int>& ids) const;
+
+    QVector<QPair<qreal, int>> mEntries; // Sorted (bearing, id) pairs
+};
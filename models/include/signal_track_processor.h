@@ -1,136 +1,65 @@
 #include "include/world_object.h"
 #include "include/sensor.h"
-#include "include/globals.h"
+#include "include/track_picture.h"
+#include "include/sensor_coverage_index.h"
+#include "include/detection_model.h"
+#include "include/occlusion_grid.h"
 
 #include <QtWidgets>
 
 #pragma once
 
-#define MAX_TRACKS 10
-
 
 /**
- * For handling how objects are detected by the senors aboard each platform
+ * For handling how objects are detected by the senors aboard each platform.
+ * Detections are reported to the faction's shared TrackPicture, which holds the tracks.
  */
 class SignalTrackProcessor
 {
 public:
-    explicit SignalTrackProcessor(WorldObject* parent, QVector<WorldObject*>* worldObjects) : mParent(parent), mWorldObjects(worldObjects) {}
+    SignalTrackProcessor(WorldObject* parent, QVector<WorldObject*>* worldObjects, TrackPicture* picture)
+    : mParent(parent), mWorldObjects(worldObjects), mPicture(picture), mRandomState(parent->mId | 1u) {}
     ~SignalTrackProcessor() = default;
 
     /**
-     * A track is a container for the information a sensor knows
-     * about a particular object in the world.
+     * Returns all of the tracks held by the faction of the platform.
+     * @return read-only view of the tracks, valid until the next TrackPicture::update()
      */
-    struct Track
-    {
-        Vector position {0, 0};
-        qreal receivedPower {0};
-        uint32_t timestamp {0};
-    };
+    TrackView getTracks() const { return mPicture->getTracks(); }
 
     /**
-     * A processed track is a container for the information the processor
-     * has inferred about an object in the world by accumulating tracks.
+     * Sweeps the sensors of the platform and reports anonymous detections of the world objects
+     * inside the scan window of any sensor to the track picture. The objects are indexed by
+     * bearing once. Each sensor then only visits the objects in its beam, each of which is
+     * detected with the probability given by the sensor's detection model.
+     * Objects whose line of sight from the platform is blocked are not detected.
+     * @param occlusion - The occluders in the world this tick.
      */
-    struct ProcessedTrack
-    {
-        uint32_t uid;
-        Vector* parentPos;
-        Vector offset {0, 0};
-        Vector acc {0, 0};
-        Vector vel {0, 0};
-        Faction faction {Faction::Unknown};
-        Track tracks[MAX_TRACKS];
-        int index {0};
-        bool isCurrent {false};
-
-        void insertTrack(Track track)
-        {
-            isCurrent = true;
-            offset = track.position - *parentPos;
-            subtractOldDelta();
-            tracks[index] = track;
-            updateProfile();
-            incrementTrack(1);
-        }
-
-        void updateProfile()
-        {
-            // Add the velocity for the latest track-delta
-            auto oldTrack = getOffsetTrack(-1);
-            if (oldTrack.timestamp == 0) {
-                return;
-            }
-            auto delta = (tracks[index].position - oldTrack.position) * (1.0f / double(tracks[index].timestamp - oldTrack.timestamp));
-            vel += delta * (1.0f / MAX_TRACKS);
-        }
-
-        void subtractOldDelta()
-        {
-            if (tracks[index].timestamp == 0) {
-                return;
-            }
-            auto plusOneTrack = getOffsetTrack(1);
-            if (plusOneTrack.timestamp == 0) {
-                return;
-            }
-            auto delta = (plusOneTrack.position - tracks[index].position) * (1.0f / double(plusOneTrack.timestamp - tracks[index].timestamp));
-            vel -= delta * (1.0f / MAX_TRACKS);
-        }
-
-        Track getOffsetTrack(int o)
-        {
-            incrementTrack(o);
-            auto offsetTrack = tracks[index];
-            incrementTrack(-o);
-            return offsetTrack;
-        }
-
-        void incrementTrack(int o)
-        {
-            index += o;
-            if (index < 0) {
-                index += MAX_TRACKS;
-            } else {
-                index %= MAX_TRACKS;
-            }
-        }
-
-        uint32_t getLastTimestamp() const
-        {
-            return tracks[index].timestamp;
-        }
-
-        void predictCurrentPosition()
-        {
-            isCurrent = false;
-            offset += vel;
-        }
-    };
-
-    /**
-     * Returns all of the valid tracks of all the world objects.
-     * @return vector of track objects
-     */
-    QVector<ProcessedTrack> getTracks();
-
-    /**
-     * Updates the tracks for all the world objects visible to the platform.
-     */
-    void computeTracks();
-
-    /**
-     * Returns a track for the given world object.
-     * @param obj - The world object to check for a valid track
-     * @return optional, Track object if valid, null otherwise.
-     */
-    void computeTrack(WorldObject* obj);
+    void computeDetections(const OcclusionGrid& occlusion);
 
     WorldObject* getParent() const { return mParent; }
 
 protected:
     WorldObject* mParent;
     QVector<WorldObject*>* mWorldObjects;
-    QMap<uint32_t, ProcessedTrack> mProcessedTracks;
+    TrackPicture* mPicture;
+    QVector<Detection> mDetections;
+    SensorCoverageIndex mCoverageIndex;
+    QVector<int> mCoveredObjects;
+    QVector<float> mEffectiveRangeSq; // Per world object, see DetectionModel
+    QVector<float> mBeamRangeSq;
+    QVector<float> mBeamProbability;
+    QVector<float> mBeamPower;
+    QVector<QPair<int, float>> mSensedObjects; // (world object, received power)
+    QVector<QPair<int, float>> mSensedUnique; // One entry per sensed world object
+    QVector<QPointF> mRayTargets;
+    QVector<uint32_t> mRayUids;
+    QVector<bool> mOccluded;
+    uint32_t mRandomState; // Never zero
+
+private:
+    /**
+     * Returns a uniformly distributed value in [0, 1).
+     */
+    float nextUniform();
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "include/track_filter.h"
+
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * An anonymous detection, i.e. what a sensor reports without knowing
+ * which object in the world produced it.
+ */
+struct Detection
+{
+    QPointF position;
+    float receivedPower {0};
+};
+
+Q_DECLARE_TYPEINFO(Detection, Q_MOVABLE_TYPE);
+
+/**
+ * Global nearest neighbour association of anonymous detections to existing tracks.
+ *
+ * Predicted track positions are bucketed into a uniform grid (one entry per cell
+ * overlapped by the track's gate), so each detection only scores the tracks that
+ * share its cell. The resulting sparse assignment problem is solved with an
+ * auction, where every detection may also fall back to starting a new track.
+ */
+class TrackAssociator
+{
+public:
+    /**
+     * @param gateThreshold - Squared Mahalanobis distance beyond which a detection cannot
+     *                        be assigned to a track (9.21 is the 99% point for 2 DoF).
+     * @param cellSize - Edge length of a spatial hash cell, in world units.
+     */
+    explicit TrackAssociator(qreal gateThreshold = 9.21, qreal cellSize = 2000);
+
+    /**
+     * Assigns each detection to at most one track, and each track to at most one detection.
+     * @param filter - The predicted tracks.
+     * @param detections - The detections made this tick.
+     * @return Per detection, the index of the assigned track or -1 if it is unassigned.
+     *         Valid until the next call.
+     */
+    const QVector<int>& associate(const TrackFilter& filter, const QVector<Detection>& detections);
+
+    /**
+     * Returns the gate radius (world units) of the given track.
+     */
+    qreal getGateRadius(const TrackFilter& filter, int index) const;
+
+private:
+    struct Candidate
+    {
+        int track;
+        float benefit;
+    };
+
+    quint64 cellKey(int cx, int cy) const { return (quint64(quint32(cx)) << 32) | quint32(cy); }
+    int cellCoord(qreal v) const { return int(qFloor(v / mCellSize)); }
+
+    void buildGrid(const TrackFilter& filter);
+    void buildCandidates(const TrackFilter& filter, const QVector<Detection>& detections);
+    void auction(int numTracks);
+
+    qreal mGateThreshold;
+    qreal mCellSize;
+
+    // Reused between ticks so association does not allocate in steady state
+    QVector<QPair<quint64, int>> mGrid; // Sorted (cell, track) pairs
+    QVector<int> mCandidateStart; // Per detection, offset into mCandidates
+    QVector<Candidate> mCandidates;
+    QVector<float> mPrices;
+    QVector<int> mOwners;
+    QVector<int> mUnassigned;
+    QVector<int> mAssignment;
+};
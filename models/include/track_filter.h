@@ -0,0 +1,102 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Batched constant-acceleration Kalman filter over every track of a processor.
+ *
+ * State is held as structure-of-arrays so that the per-tick predict and
+ * correct passes are flat loops over contiguous floats. The x and y axes are
+ * modelled independently with identical noise, so both share one covariance.
+ * Tracks are indexed densely, mirroring the owning TrackTable.
+ */
+class TrackFilter
+{
+public:
+    /**
+     * @param measurementVar - Variance of a position measurement.
+     * @param processVar - Variance of the (white noise) jerk driving the acceleration.
+     */
+    explicit TrackFilter(qreal measurementVar = 4.0, qreal processVar = 0.0001);
+
+    /**
+     * Starts a new track at the given position with no velocity or acceleration.
+     * @param z - The position of the first detection.
+     * @return The index of the new track.
+     */
+    int add(QPointF z);
+
+    /**
+     * Removes the track at the given index, moving the last track into its place.
+     */
+    void remove(int index);
+
+    /**
+     * Records a position measurement for the track, applied on the next update().
+     */
+    void setMeasurement(int index, QPointF z);
+
+    /**
+     * Discards all pending measurements.
+     */
+    void clearMeasurements();
+
+    /**
+     * Advances every track by one tick.
+     */
+    void predict();
+
+    /**
+     * Corrects every track that has a pending measurement against it.
+     * Measurements stay flagged until clearMeasurements().
+     */
+    void correct();
+
+    int size() const { return mPosX.size(); }
+    bool hasMeasurement(int index) const { return mHasMeasurement[index] != 0; }
+    QPointF getPosition(int index) const { return {mPosX[index], mPosY[index]}; }
+    QPointF getVelocity(int index) const { return {mVelX[index], mVelY[index]}; }
+    QPointF getAcceleration(int index) const { return {mAccX[index], mAccY[index]}; }
+
+    /**
+     * Returns the variance of the predicted position (per axis).
+     */
+    qreal getPositionVariance(int index) const { return mP00[index]; }
+
+    /**
+     * Returns the innovation variance (per axis) a new measurement would have.
+     */
+    qreal getInnovationVariance(int index) const { return mP00[index] + mMeasurementVar; }
+
+    /**
+     * Returns the squared Mahalanobis distance of the given measurement from the
+     * predicted track position, for gating. Distributed chi-squared with 2 DoF.
+     */
+    qreal getGateDistance(int index, QPointF z) const;
+
+private:
+    float mMeasurementVar;
+    float mProcessVar;
+
+    // State, per axis
+    QVector<float> mPosX;
+    QVector<float> mPosY;
+    QVector<float> mVelX;
+    QVector<float> mVelY;
+    QVector<float> mAccX;
+    QVector<float> mAccY;
+
+    // Upper triangle of the (symmetric) state covariance, shared by both axes
+    QVector<float> mP00;
+    QVector<float> mP01;
+    QVector<float> mP02;
+    QVector<float> mP11;
+    QVector<float> mP12;
+    QVector<float> mP22;
+
+    // Pending measurements
+    QVector<float> mMeasX;
+    QVector<float> mMeasY;
+    QVector<float> mHasMeasurement; // 1 or 0, kept as a float so the correction is branch-free
+};
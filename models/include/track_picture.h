@@ -0,0 +1,84 @@
+#include "include/globals.h"
+#include "include/track_table.h"
+#include "include/track_filter.h"
+#include "include/track_associator.h"
+
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Fused track picture shared by every platform of a faction (i.e. a data link).
+ *
+ * Each platform submits the detections from its own sensor sweep, then the picture
+ * is updated once per tick: every track is predicted once, and each platform's
+ * detections are associated and corrected in turn (a sequential measurement update),
+ * so an object seen by several platforms still only holds one track.
+ */
+class TrackPicture
+{
+public:
+    TrackPicture() = default;
+    ~TrackPicture() = default;
+
+    /**
+     * Returns all of the fused tracks.
+     * @return read-only view of the tracks, valid until the next update()
+     */
+    TrackView getTracks() const { return mProcessedTracks.view(); }
+
+    /**
+     * Returns the track with the given uid, or nullptr if it is not (or no longer) held.
+     */
+    const ProcessedTrack* getTrack(uint32_t uid) const { return mProcessedTracks.find(uid); }
+
+    /**
+     * Returns the uids of the tracks dropped by the last update().
+     */
+    const QVector<uint32_t>& getDroppedTracks() const { return mDroppedTracks; }
+
+    /**
+     * Returns the uids of the tracks created or detected again by the last update().
+     * A track detected by several platforms is listed once per platform.
+     */
+    const QVector<uint32_t>& getUpdatedTracks() const { return mUpdatedTracks; }
+
+    /**
+     * Queues the detections made by one platform this tick.
+     * @param detections - The detections, positions in world coordinates.
+     */
+    void addDetections(const QVector<Detection>& detections);
+
+    /**
+     * Fuses every queued detection into the tracks, then clears the queue.
+     */
+    void update();
+
+private:
+    /**
+     * Removes every track whose predicted position is too uncertain to be associated.
+     */
+    void dropLostTracks();
+
+    /**
+     * Associates and corrects the tracks against the detections of a single platform.
+     */
+    void fuseBatch(const QVector<Detection>& detections);
+
+    TrackTable mProcessedTracks;
+    TrackFilter mTrackFilter; // Indexed in step with mProcessedTracks
+    TrackAssociator mTrackAssociator;
+
+    QVector<Detection> mQueuedDetections;
+    QVector<int> mBatchStart; // Offset of each platform's detections in mQueuedDetections
+    QVector<Detection> mBatch;
+    QVector<uint32_t> mDroppedTracks;
+    QVector<uint32_t> mUpdatedTracks;
+
+    // Tracks are dropped once their gate grows beyond this (world units)
+    constexpr static qreal sMaxGateRadius {10000};
+
+    // Track uids are local to the picture, UID 0 is reserved as a null track
+    uint32_t mNextTrackUid {1};
+};
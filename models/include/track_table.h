@@ -0,0 +1,160 @@
+#include "include/faction.h"
+
+#include <QtWidgets>
+
+#pragma once
+
+#define MAX_TRACKS 10
+
+
+/**
+ * A track is a container for the information a sensor knows
+ * about a particular object in the world.
+ */
+struct Track
+{
+    float x {0};
+    float y {0};
+    float receivedPower {0};
+    uint32_t timestamp {0};
+
+    QPointF position() const { return {x, y}; }
+};
+
+/**
+ * A processed track is a container for the information a faction
+ * has inferred about an object in the world by accumulating tracks. The
+ * kinematics (in world coordinates) are written from the TrackFilter.
+ */
+struct ProcessedTrack
+{
+    uint32_t uid {0};
+    QPointF position;
+    QPointF acc;
+    QPointF vel;
+    Faction faction {Faction::Unknown};
+    Track tracks[MAX_TRACKS]; // Ring buffer of the most recent tracks
+    int index {0};
+    bool isCurrent {false};
+
+    void insertTrack(Track track)
+    {
+        tracks[index] = track;
+        incrementTrack(1);
+    }
+
+    Track getOffsetTrack(int o) const
+    {
+        int i = index + o;
+        if (i < 0) {
+            i += MAX_TRACKS;
+        } else {
+            i %= MAX_TRACKS;
+        }
+        return tracks[i];
+    }
+
+    void incrementTrack(int o)
+    {
+        index += o;
+        if (index < 0) {
+            index += MAX_TRACKS;
+        } else {
+            index %= MAX_TRACKS;
+        }
+    }
+
+    uint32_t getLastTimestamp() const
+    {
+        return getOffsetTrack(-1).timestamp;
+    }
+};
+
+Q_DECLARE_TYPEINFO(Track, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(ProcessedTrack, Q_MOVABLE_TYPE);
+
+/**
+ * Read-only view over a contiguous run of processed tracks. Views are
+ * invalidated by any insertion into, or removal from, the owning table.
+ */
+class TrackView
+{
+public:
+    TrackView(const ProcessedTrack* begin, const ProcessedTrack* end) : mBegin(begin), mEnd(end) {}
+
+    const ProcessedTrack* begin() const { return mBegin; }
+    const ProcessedTrack* end() const { return mEnd; }
+    const ProcessedTrack& operator[](int i) const { return mBegin[i]; }
+    int size() const { return int(mEnd - mBegin); }
+    bool empty() const { return mBegin == mEnd; }
+
+private:
+    const ProcessedTrack* mBegin;
+    const ProcessedTrack* mEnd;
+};
+
+/**
+ * Flat open-addressing (linear probing) table of processed tracks keyed by uid.
+ * The tracks themselves are held densely so they can be iterated without
+ * chasing pointers, the probe table only holds the uid and the dense index.
+ */
+class TrackTable
+{
+public:
+    explicit TrackTable(int capacity = 16);
+
+    /**
+     * Returns the track for the given uid.
+     * @param uid - The uid of the track, must be non-zero.
+     * @return Pointer to the track if present, nullptr otherwise.
+     */
+    ProcessedTrack* find(uint32_t uid);
+    const ProcessedTrack* find(uint32_t uid) const;
+
+    /**
+     * Returns the track for the given uid, creating an empty track if
+     * one is not already present.
+     * @param uid - The uid of the track, must be non-zero.
+     */
+    ProcessedTrack& insert(uint32_t uid);
+
+    /**
+     * Returns the dense index of the track for the given uid, or -1 if not present.
+     * Tracks are appended, so a newly inserted track always has the last index.
+     */
+    int indexOf(uint32_t uid) const;
+
+    /**
+     * Removes the track for the given uid (if present). The last track is
+     * moved into the freed position so storage stays dense.
+     * @param uid - The uid of the track to remove.
+     */
+    void remove(uint32_t uid);
+
+    ProcessedTrack& at(int index) { return mTracks[index]; }
+    TrackView view() const { return {mTracks.constData(), mTracks.constData() + mTracks.size()}; }
+    ProcessedTrack* begin() { return mTracks.data(); }
+    ProcessedTrack* end() { return mTracks.data() + mTracks.size(); }
+    int size() const { return mTracks.size(); }
+    bool empty() const { return mTracks.empty(); }
+
+private:
+    struct Slot
+    {
+        uint32_t uid {0}; // 0 is reserved as the null uid, so marks an empty slot
+        int index {-1};
+    };
+
+    /**
+     * Returns the slot holding the given uid, or the empty slot
+     * the uid would be inserted into.
+     */
+    int probe(uint32_t uid) const;
+    int home(uint32_t uid) const { return int((uid * 2654435769u) >> mShift); }
+    void grow();
+
+    QVector<ProcessedTrack> mTracks;
+    QVector<Slot> mSlots;
+    int mMask;
+    int mShift;
+};
@@ -0,0 +1,73 @@
+#include "include/detection_model.h"
+
+
+std::shared_ptr<const DetectionModel> DetectionModel::get(qreal txPower, qreal noiseFloor)
+{
+    static QMap<QPair<qreal, qreal>, std::shared_ptr<const DetectionModel>> sModels;
+    auto& model = sModels[{txPower, noiseFloor}];
+    if (!model) {
+        model = std::shared_ptr<const DetectionModel>(new DetectionModel(txPower, noiseFloor));
+    }
+    return model;
+}
+
+DetectionModel::DetectionModel(qreal txPower, qreal noiseFloor)
+    : mNoiseless(noiseFloor <= 0), mPowerScale(txPower * sRadarGain)
+{
+    if (mNoiseless) {
+        mMaxRangeSq = std::numeric_limits<float>::max();
+        mFirstBin = 0;
+        return;
+    }
+
+    // The SNR at which detection becomes negligible sets the extent of the table
+    qreal minSNR = (qLn(sFalseAlarmProbability) / qLn(sMinProbability)) - 1.0;
+    qreal maxRangeSq = qSqrt(mPowerScale / (noiseFloor * minSNR));
+    mMaxRangeSq = float(maxRangeSq);
+    // The table ends with the octave holding the maximum range
+    int firstOctave = qMax(0, int(getBinKey(mMaxRangeSq) >> sMantissaBits) - (sTableOctaves - 1));
+    mFirstBin = quint32(firstOctave) << sMantissaBits;
+
+    mProbabilityTable.resize(sTableSize);
+    for (int i = 0; i < sTableSize; i++)
+    {
+        // Sample at the bin centre, half way along its mantissa step
+        quint32 bits = ((mFirstBin + quint32(i)) << (23 - sMantissaBits)) | (1u << (22 - sMantissaBits));
+        float binCentre;
+        memcpy(&binCentre, &bits, sizeof(binCentre));
+        qreal rangeSq = binCentre;
+        qreal snr = mPowerScale / (rangeSq * rangeSq * noiseFloor);
+        mProbabilityTable[i] = float(qPow(sFalseAlarmProbability, 1.0 / (1.0 + snr)));
+    }
+}
+
+void DetectionModel::evaluate(const QVector<float>& effectiveRangeSq, QVector<float>& probability, QVector<float>& power) const
+{
+    const int n = effectiveRangeSq.size();
+    probability.resize(n);
+    power.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        // Clamped so a target on top of the sensor does not return an infinite power
+        qreal rangeSq = qMax(qreal(effectiveRangeSq[i]), 1.0);
+        power[i] = float(mPowerScale / (rangeSq * rangeSq));
+    }
+    if (mNoiseless)
+    {
+        for (int i = 0; i < n; i++) {
+            probability[i] = 1;
+        }
+        return;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        if (effectiveRangeSq[i] >= mMaxRangeSq) {
+            probability[i] = 0;
+            continue;
+        }
+        // Anything closer than the start of the table is as certain as its first bin
+        qint64 bin = qint64(getBinKey(effectiveRangeSq[i])) - mFirstBin;
+        probability[i] = mProbabilityTable[int(qBound(qint64(0), bin, qint64(sTableSize - 1)))];
+    }
+}
@@ -0,0 +1,66 @@
+#include "include/guidance_kernel.h"
+
+
+GuidanceKernel::GuidanceKernel(qreal navigationGain, bool augmented)
+    : mNavigationGain(float(navigationGain)), mAugmentedGain(augmented ? float(0.5*navigationGain) : 0.0f)
+{
+}
+
+void GuidanceKernel::clear()
+{
+    mRelPosX.clear();
+    mRelPosY.clear();
+    mRelVelX.clear();
+    mRelVelY.clear();
+    mTargetAccX.clear();
+    mTargetAccY.clear();
+    mMaxAcc.clear();
+}
+
+int GuidanceKernel::add(QPointF relPos, QPointF relVel, QPointF targetAcc, qreal maxAcc)
+{
+    mRelPosX.append(float(relPos.x()));
+    mRelPosY.append(float(relPos.y()));
+    mRelVelX.append(float(relVel.x()));
+    mRelVelY.append(float(relVel.y()));
+    mTargetAccX.append(float(targetAcc.x()));
+    mTargetAccY.append(float(targetAcc.y()));
+    mMaxAcc.append(float(maxAcc));
+    return mRelPosX.size() - 1;
+}
+
+void GuidanceKernel::compute()
+{
+    const int n = size();
+    mBearing.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        float rx = mRelPosX[i];
+        float ry = mRelPosY[i];
+        float vx = mRelVelX[i];
+        float vy = mRelVelY[i];
+        float rangeSq = qMax(rx*rx + ry*ry, 1.0f);
+        float rangeInv = 1.0f / std::sqrt(rangeSq);
+
+        // Line of sight unit vector and its normal
+        float ux = rx * rangeInv;
+        float uy = ry * rangeInv;
+        float nx = -uy;
+        float ny = ux;
+
+        float losRate = (rx*vy - ry*vx) / rangeSq;
+        // Until the missile is closing it simply accelerates down the line of sight
+        float closing = qMax(-(rx*vx + ry*vy) * rangeInv, 0.0f);
+        float targetAccNormal = mTargetAccX[i]*nx + mTargetAccY[i]*ny;
+
+        float maxAcc = mMaxAcc[i];
+        float lateral = mNavigationGain*closing*losRate + mAugmentedGain*targetAccNormal;
+        lateral = qBound(-maxAcc, lateral, maxAcc);
+        // A missile not yet thrusting is simply pointed down the line of sight
+        float along = maxAcc > 0 ? std::sqrt(maxAcc*maxAcc - lateral*lateral) : 1.0f;
+
+        float ax = lateral*nx + along*ux;
+        float ay = lateral*ny + along*uy;
+        mBearing[i] = qAtan2(ay, ax) + 0.5*M_PI;
+    }
+}
@@ -1,26 +1,71 @@
 #include "include/guidance_processor.h"
 
 
-void GuidanceProcessor::guideToMostValidTarget()
+void GuidanceProcessor::submitGuidance(GuidanceKernel& kernel)
 {
-    if (mProcessedTracks.empty()) {
+    mKernelIndex = -1;
+
+    // Tracks are in the (moving) world frame, so the parent's own frame velocity
+    // is taken from its displacement rather than its inertial velocity
+    QPointF position {mParent->mP.x(), mParent->mP.y()};
+    QPointF velocity = mHasLastPosition ? position - mLastPosition : QPointF(mParent->mV.x(), mParent->mV.y());
+    mLastPosition = position;
+    mHasLastPosition = true;
+
+    updateTargetScores(position, velocity);
+    if (mTargets.empty()) {
+        return;
+    }
+    const auto& track = *mPicture->getTrack(mTargets.top());
+    mKernelIndex = kernel.add(track.position - position, track.vel - velocity, track.acc,
+                              mParent->mA.getSize());
+}
+
+void GuidanceProcessor::applyGuidance(const GuidanceKernel& kernel)
+{
+    if (mKernelIndex < 0) {
         return;
     }
-    // Most valid target is just the most recently seen one
-    auto track = *std::max_element(mProcessedTracks.begin(), mProcessedTracks.end(),
-                                   [](auto id, auto track)
-                                   {
-                                       return track.getLastTimestamp();
-                                   });
-    qreal altAtan2 = qAtan2(track.offset.y(), track.offset.x()) + 0.5*M_PI;
-    auto targetBearing = Bearing(altAtan2);
+    mParent->rotate(Bearing(kernel.getBearing(mKernelIndex)));
+}
 
-    Bearing delta = targetBearing - mLastValidBearing;
-    if (mLastTarget != track.uid) {
-        delta = 0;
-        mLastTarget = track.uid;
+void GuidanceProcessor::updateTargetScores(QPointF position, QPointF velocity)
+{
+    for (auto uid : mPicture->getDroppedTracks()) {
+        mTargets.remove(uid);
+    }
+    // A recency score only changes when the track is detected again, so after the
+    // first tick only the tracks the picture updated are rescored
+    if (mTargetScore == TargetScore::Recency && mIsScored)
+    {
+        for (auto uid : mPicture->getUpdatedTracks()) {
+            mTargets.update(uid, computeScore(*mPicture->getTrack(uid), position, velocity));
+        }
+        return;
     }
+    // The geometric scores change with every move of the parent or the track
+    for (const auto& track : getTracks()) {
+        mTargets.update(track.uid, computeScore(track, position, velocity));
+    }
+    mIsScored = true;
+}
 
-    mParent->rotate(targetBearing + delta);
-    mLastValidBearing = targetBearing + delta;
-}
\ No newline at end of file
+float GuidanceProcessor::computeScore(const ProcessedTrack& track, QPointF position, QPointF velocity) const
+{
+    QPointF r = track.position - position;
+    QPointF v = track.vel - velocity;
+    qreal range = qMax(qSqrt(r.x()*r.x() + r.y()*r.y()), 1.0);
+    qreal closureRate = -(r.x()*v.x() + r.y()*v.y()) / range;
+    switch (mTargetScore)
+    {
+        case TargetScore::Recency:
+            return float(track.getLastTimestamp());
+        case TargetScore::Range:
+            return float(-range);
+        case TargetScore::ClosureRate:
+            return float(closureRate);
+        case TargetScore::Threat:
+            return float(closureRate / range);
+    }
+    return 0;
+}
@@ -1,63 +1,56 @@
 #include "include/heat_flow.h"
 
 
-void HeatFlow::compute()
+void HeatFlow::updateNeighbours(const QMap<QPair<int, int>, int>& componentIndex)
 {
-    // Temperature exhaust flow
-    QMapIterator compIter(mComponentMap);
-    while (compIter.hasNext())
-    {
-        compIter.next();
-        int x = compIter.key().first;
-        int y = compIter.key().second;
-        computeHeatExhaust(compIter.value(), x-1, y);
-        computeHeatExhaust(compIter.value(), x+1, y);
-        computeHeatExhaust(compIter.value(), x, y-1);
-        computeHeatExhaust(compIter.value(), x, y+1);
-    }
-
-    // Temperature flow between components
-    compIter.toFront();
-    while (compIter.hasNext())
-    {
-        compIter.next();
-        auto c = compIter.value();
-        int x = compIter.key().first;
-        int y = compIter.key().second;
-
-        computeHeatFlow(c, x-1, y);
-        computeHeatFlow(c, x+1, y);
-        computeHeatFlow(c, x, y-1);
-        computeHeatFlow(c, x, y+1);
-    }
-    for (auto c : mTempDeltas.keys())
+    mNeighbours.resize(mComponents.size());
+    mValidNeighbours.fill(0, mComponents.size());
+    mTempDeltas.fill(0, mComponents.size());
+    for (int i = 0; i < mComponents.size(); i++)
     {
-        c->applyTemperatureDelta(mTempDeltas[c]);
+        int x = mComponents[i].x();
+        int y = mComponents[i].y();
+        mNeighbours[i] = {componentIndex.value({x-1, y}, -1),
+                          componentIndex.value({x+1, y}, -1),
+                          componentIndex.value({x, y-1}, -1),
+                          componentIndex.value({x, y+1}, -1)};
+        mValidNeighbours[i] = int(std::count_if(mNeighbours[i].cbegin(), mNeighbours[i].cend(),
+                                                [](int n){ return n >= 0; }));
     }
 }
 
-void HeatFlow::computeHeatFlow(const std::shared_ptr<Component>& src, int x, int y)
+void HeatFlow::compute()
 {
-    if (mComponentMap.contains({x, y}))
+    // Temperature exhaust flow, reduce the temperature for every unconnected face
+    for (int i = 0; i < mComponents.size(); i++)
     {
-        auto dst = mComponentMap[{x, y}];
-        if (src->getTemperature() > dst->getTemperature())
+        for (int n : mNeighbours[i])
         {
-            qreal delta = (src->getTemperature()-dst->getTemperature()) * (dst->getHeatInRatio()) / mValidNeighbours[src];
-            mTempDeltas[src] -= delta;
-            mTempDeltas[dst] += delta;
+            if (n < 0)
+                mComponents[i].applyTemperatureDelta(-mComponents[i].getTemperature()*0.001);
         }
     }
-}
 
-void HeatFlow::computeHeatExhaust(const std::shared_ptr<Component>& src, int x, int y)
-{
-    if (!mComponentMap.contains({x, y}))
+    // Temperature flow between components
+    std::fill(mTempDeltas.begin(), mTempDeltas.end(), 0);
+    for (int i = 0; i < mComponents.size(); i++)
     {
-        src->applyTemperatureDelta(-src->getTemperature()*0.001);
+        const auto& src = mComponents[i];
+        for (int n : mNeighbours[i])
+        {
+            if (n < 0)
+                continue;
+            const auto& dst = mComponents[n];
+            if (src.getTemperature() > dst.getTemperature())
+            {
+                qreal delta = (src.getTemperature()-dst.getTemperature()) * (dst.getHeatInRatio()) / mValidNeighbours[i];
+                mTempDeltas[i] -= delta;
+                mTempDeltas[n] += delta;
+            }
+        }
     }
-    else
+    for (int i = 0; i < mComponents.size(); i++)
     {
-        mValidNeighbours[src]++;
+        mComponents[i].applyTemperatureDelta(mTempDeltas[i]);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,87 @@
+#include "include/indexed_heap.h"
+
+
+void IndexedHeap::update(uint32_t uid, float score)
+{
+    int i = mPositions.value(uid, -1);
+    if (i < 0)
+    {
+        mHeap.append({uid, score});
+        mPositions.insert(uid, mHeap.size() - 1);
+        siftUp(mHeap.size() - 1);
+        return;
+    }
+
+    float previous = mHeap[i].score;
+    mHeap[i].score = score;
+    if (score > previous) {
+        siftUp(i);
+    } else if (score < previous) {
+        siftDown(i);
+    }
+}
+
+void IndexedHeap::remove(uint32_t uid)
+{
+    int i = mPositions.value(uid, -1);
+    if (i < 0) {
+        return;
+    }
+    mPositions.remove(uid);
+
+    // Move the last entry into the hole, then restore the heap in whichever direction it violates
+    Entry last = mHeap.takeLast();
+    if (i == mHeap.size()) {
+        return;
+    }
+    float previous = mHeap[i].score;
+    place(i, last);
+    if (last.score > previous) {
+        siftUp(i);
+    } else {
+        siftDown(i);
+    }
+}
+
+void IndexedHeap::siftUp(int i)
+{
+    Entry entry = mHeap[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (mHeap[parent].score >= entry.score) {
+            break;
+        }
+        place(i, mHeap[parent]);
+        i = parent;
+    }
+    place(i, entry);
+}
+
+void IndexedHeap::siftDown(int i)
+{
+    Entry entry = mHeap[i];
+    const int n = mHeap.size();
+    while (true)
+    {
+        int child = 2*i + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n && mHeap[child + 1].score > mHeap[child].score) {
+            child++;
+        }
+        if (mHeap[child].score <= entry.score) {
+            break;
+        }
+        place(i, mHeap[child]);
+        i = child;
+    }
+    place(i, entry);
+}
+
+void IndexedHeap::place(int i, const Entry& entry)
+{
+    mHeap[i] = entry;
+    mPositions[entry.uid] = i;
+}
@@ -0,0 +1,183 @@
+#include "include/occlusion_grid.h"
+
+
+OcclusionGrid::OcclusionGrid(qreal cellSize) : mPreferredCellSize(cellSize)
+{
+}
+
+void OcclusionGrid::clear()
+{
+    mOccluders.clear();
+    mRadii.clear();
+}
+
+void OcclusionGrid::add(QPointF centre, qreal radius, uint32_t uid)
+{
+    if (radius <= 0) {
+        return;
+    }
+    mOccluders.append({float(centre.x()), float(centre.y()), float(radius*radius), uid});
+    mRadii.append(float(radius));
+}
+
+void OcclusionGrid::build()
+{
+    mCellStart.clear();
+    mCellOccluders.clear();
+    if (mOccluders.empty()) {
+        return;
+    }
+
+    mMinX = mMinY = std::numeric_limits<qreal>::max();
+    mMaxX = mMaxY = std::numeric_limits<qreal>::lowest();
+    for (int i = 0; i < mOccluders.size(); i++)
+    {
+        const auto& o = mOccluders[i];
+        mMinX = qMin(mMinX, qreal(o.x - mRadii[i]));
+        mMinY = qMin(mMinY, qreal(o.y - mRadii[i]));
+        mMaxX = qMax(mMaxX, qreal(o.x + mRadii[i]));
+        mMaxY = qMax(mMaxY, qreal(o.y + mRadii[i]));
+    }
+
+    // Widely spread occluders (e.g. distant ships) get coarser cells rather than a huge grid
+    qreal width = mMaxX - mMinX;
+    qreal height = mMaxY - mMinY;
+    mCellSize = qMax(mPreferredCellSize, qSqrt(width * height / sMaxCells));
+    mCellSize = qMax(mCellSize, qMax(width, height) / sMaxCells);
+    mCellScale = 1.0 / mCellSize;
+    mCellsX = qMax(1, int(width * mCellScale) + 1);
+    mCellsY = qMax(1, int(height * mCellScale) + 1);
+
+    // Counting sort of (cell, occluder) pairs, one entry per cell an occluder overlaps
+    mCellStart.fill(0, mCellsX * mCellsY + 1);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < mOccluders.size(); i++)
+        {
+            const auto& o = mOccluders[i];
+            for (int cy = cellY(o.y - mRadii[i]); cy <= cellY(o.y + mRadii[i]); cy++) {
+                for (int cx = cellX(o.x - mRadii[i]); cx <= cellX(o.x + mRadii[i]); cx++) {
+                    int cell = cy * mCellsX + cx;
+                    if (pass == 0) {
+                        mCellStart[cell + 1]++;
+                    } else {
+                        mCellOccluders[mCellStart[cell]++] = i;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int c = 0; c < mCellsX * mCellsY; c++) {
+                mCellStart[c + 1] += mCellStart[c];
+            }
+            mCellOccluders.resize(mCellStart.last());
+        }
+    }
+    // The fill pass advanced each start to the next cell's start, so shift back
+    for (int c = mCellsX * mCellsY; c > 0; c--) {
+        mCellStart[c] = mCellStart[c - 1];
+    }
+    mCellStart[0] = 0;
+}
+
+bool OcclusionGrid::testCell(int cell, QPointF from, QPointF delta, qreal lengthSqInv, uint32_t fromUid, uint32_t toUid) const
+{
+    for (int k = mCellStart[cell]; k < mCellStart[cell + 1]; k++)
+    {
+        const auto& o = mOccluders[mCellOccluders[k]];
+        if (o.uid != 0 && (o.uid == fromUid || o.uid == toUid)) {
+            continue;
+        }
+        // Closest point on the segment to the centre of the occluder
+        qreal cx = o.x - from.x();
+        qreal cy = o.y - from.y();
+        qreal s = qBound(0.0, (cx*delta.x() + cy*delta.y()) * lengthSqInv, 1.0);
+        qreal dx = cx - s*delta.x();
+        qreal dy = cy - s*delta.y();
+        if (dx*dx + dy*dy < o.radiusSq) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OcclusionGrid::isOccluded(QPointF from, QPointF to, uint32_t fromUid, uint32_t toUid) const
+{
+    if (mOccluders.empty()) {
+        return false;
+    }
+    QPointF delta = to - from;
+    qreal lengthSq = delta.x()*delta.x() + delta.y()*delta.y();
+    if (lengthSq <= 0) {
+        return false;
+    }
+    qreal lengthSqInv = 1.0 / lengthSq;
+
+    // Clip the segment to the bounds of the grid (Liang-Barsky)
+    qreal t0 = 0;
+    qreal t1 = 1;
+    const qreal p[4] = {-delta.x(), delta.x(), -delta.y(), delta.y()};
+    const qreal q[4] = {from.x() - mMinX, mMaxX - from.x(), from.y() - mMinY, mMaxY - from.y()};
+    for (int i = 0; i < 4; i++)
+    {
+        if (p[i] == 0) {
+            if (q[i] < 0) return false;
+            continue;
+        }
+        qreal t = q[i] / p[i];
+        if (p[i] < 0) {
+            t0 = qMax(t0, t);
+        } else {
+            t1 = qMin(t1, t);
+        }
+        if (t0 > t1) {
+            return false;
+        }
+    }
+
+    // Walk the cells between the clipped end points
+    QPointF start = from + delta * t0;
+    int cx = cellX(start.x());
+    int cy = cellY(start.y());
+    int endX = cellX(from.x() + delta.x() * t1);
+    int endY = cellY(from.y() + delta.y() * t1);
+    int stepX = delta.x() > 0 ? 1 : -1;
+    int stepY = delta.y() > 0 ? 1 : -1;
+
+    // Ray parameter at which the next cell boundary is crossed, and the parameter per cell
+    const qreal inf = std::numeric_limits<qreal>::infinity();
+    qreal tDeltaX = delta.x() != 0 ? qAbs(mCellSize / delta.x()) : inf;
+    qreal tDeltaY = delta.y() != 0 ? qAbs(mCellSize / delta.y()) : inf;
+    qreal tMaxX = delta.x() != 0 ? (mMinX + (cx + (stepX > 0 ? 1 : 0)) * mCellSize - from.x()) / delta.x() : inf;
+    qreal tMaxY = delta.y() != 0 ? (mMinY + (cy + (stepY > 0 ? 1 : 0)) * mCellSize - from.y()) / delta.y() : inf;
+
+    int remaining = qAbs(endX - cx) + qAbs(endY - cy);
+    while (true)
+    {
+        if (testCell(cy * mCellsX + cx, from, delta, lengthSqInv, fromUid, toUid)) {
+            return true;
+        }
+        if (remaining-- <= 0) {
+            return false;
+        }
+        if (tMaxX < tMaxY) {
+            cx += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            cy += stepY;
+            tMaxY += tDeltaY;
+        }
+        if (cx < 0 || cx >= mCellsX || cy < 0 || cy >= mCellsY) {
+            return false;
+        }
+    }
+}
+
+void OcclusionGrid::computeOcclusion(QPointF from, uint32_t fromUid, const QVector<QPointF>& targets,
+                                     const QVector<uint32_t>& targetUids, QVector<bool>& occluded) const
+{
+    occluded.resize(targets.size());
+    for (int i = 0; i < targets.size(); i++) {
+        occluded[i] = isOccluded(from, targets[i], fromUid, targetUids[i]);
+    }
+}
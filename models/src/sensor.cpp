@@ -1,7 +1,7 @@
 #include "include/sensor.h"
 
 
-void Sensor::update(QPointF parentPosition, Bearing parentAngle)
+void Sensor::update()
 {
     if (mIsActive && mSweepEnabled)
     {
@@ -26,8 +26,6 @@ void Sensor::update(QPointF parentPosition, Bearing parentAngle)
             }
         }
     }
-    if (mItem)
-        mItem->updateScan(parentPosition, parentAngle + mBoreAngleOffset, mScanPosition);
 }
 
 bool Sensor::withinFOV(qreal offBoreAngle) const
@@ -0,0 +1,58 @@
+#include "include/sensor_coverage_index.h"
+
+
+void SensorCoverageIndex::add(qreal offBoreAngle, int id)
+{
+    mEntries.append({wrap(offBoreAngle), id});
+}
+
+void SensorCoverageIndex::build()
+{
+    std::sort(mEntries.begin(), mEntries.end());
+}
+
+void SensorCoverageIndex::query(qreal centre, qreal halfWidth, QVector<int>& ids) const
+{
+    if (halfWidth >= M_PI)
+    {
+        queryRange(-M_PI, M_PI, ids);
+        return;
+    }
+    centre = wrap(centre);
+    qreal start = centre - halfWidth;
+    qreal end = centre + halfWidth;
+
+    // Split arcs that straddle the +/- pi seam
+    if (start < -M_PI)
+    {
+        queryRange(start + 2.0*M_PI, M_PI, ids);
+        queryRange(-M_PI, end, ids);
+    }
+    else if (end >= M_PI)
+    {
+        queryRange(start, M_PI, ids);
+        queryRange(-M_PI, end - 2.0*M_PI, ids);
+    }
+    else
+    {
+        queryRange(start, end, ids);
+    }
+}
+
+void SensorCoverageIndex::queryRange(qreal start, qreal end, QVector<int>& ids) const
+{
+    auto first = std::lower_bound(mEntries.cbegin(), mEntries.cend(), start,
+                                  [](const auto& entry, qreal angle) { return entry.first < angle; });
+    auto last = std::upper_bound(first, mEntries.cend(), end,
+                                 [](qreal angle, const auto& entry) { return angle < entry.first; });
+    for (auto it = first; it != last; it++) {
+        ids.append(it->second);
+    }
+}
+
+qreal SensorCoverageIndex::wrap(qreal angle)
+{
+    while (angle >= M_PI) angle -= 2.0*M_PI;
+    while (angle < -M_PI) angle += 2.0*M_PI;
+    return angle;
+}
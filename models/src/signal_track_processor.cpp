@@ -1,48 +1,85 @@
 #include "include/signal_track_processor.h"
 
 
-QVector<SignalTrackProcessor::ProcessedTrack> SignalTrackProcessor::getTracks()
+void SignalTrackProcessor::computeDetections(const OcclusionGrid& occlusion)
 {
-    return [this]()
+    mDetections.clear();
+    mCoverageIndex.clear();
+    mEffectiveRangeSq.resize(mWorldObjects->size());
+    for (int i = 0; i < mWorldObjects->size(); i++)
     {
-        QVector<SignalTrackProcessor::ProcessedTrack> tracks;
-        for (auto track : mProcessedTracks.values()) {
-            tracks << track;
+        auto obj = (*mWorldObjects)[i];
+        // Sensors ignore objects belonging to the same faction
+        if (mParent->mId != obj->mId && mParent->mFaction != obj->mFaction)
+        {
+            qreal dx = obj->mP.x() - mParent->mP.x();
+            qreal dy = obj->mP.y() - mParent->mP.y();
+            qreal sepAngle = qAtan2(dy, dx) + 0.5*M_PI;
+            mCoverageIndex.add(mParent->mAtan2.getDelta(sepAngle), i);
+            mEffectiveRangeSq[i] = DetectionModel::effectiveRangeSquared(dx*dx + dy*dy, obj->mRootCrossSectionInv);
         }
-        return tracks;
-    }();
-}
-
-void SignalTrackProcessor::computeTracks()
-{
-    std::for_each(mWorldObjects->begin(), mWorldObjects->end(),
-                  [this](auto obj)
-                  {
-                      // Sensors ignore menu_items belonging to the same faction
-                      if (mParent->mId != obj->mId && mParent->mFaction != obj->mFaction)
-                      {
-                          computeTrack(obj);
-                      }
-                  });
-}
+    }
+    mCoverageIndex.build();
 
-void SignalTrackProcessor::computeTrack(WorldObject* obj)
-{
-    qreal sepAngle = qAtan2( obj->mP.y() - mParent->mP.y(), obj->mP.x() - mParent->mP.x()) + 0.5*M_PI;
-    qreal offBoreAngle = mParent->mAtan2.getDelta(sepAngle);
+    mSensedObjects.clear();
     for (const auto& sensor : mParent->mSensors)
     {
-        // TODO: More fidelity
-        if (sensor->withinFOV(offBoreAngle))
+        if (!sensor->isActive()) {
+            continue;
+        }
+        mCoveredObjects.clear();
+        mCoverageIndex.query(sensor->getScanCentre(), sensor->getScanHalfWidth(), mCoveredObjects);
+
+        // Evaluate the whole beam in one pass over the sensor's tables
+        mBeamRangeSq.resize(mCoveredObjects.size());
+        for (int k = 0; k < mCoveredObjects.size(); k++) {
+            mBeamRangeSq[k] = mEffectiveRangeSq[mCoveredObjects[k]];
+        }
+        sensor->getDetectionModel().evaluate(mBeamRangeSq, mBeamProbability, mBeamPower);
+        for (int k = 0; k < mCoveredObjects.size(); k++)
         {
-            if (mProcessedTracks.find(obj->mId) == mProcessedTracks.end()) {
-                mProcessedTracks[obj->mId] = ProcessedTrack{obj->mId, &mParent->mP};
+            if (nextUniform() < mBeamProbability[k]) {
+                mSensedObjects.append({mCoveredObjects[k], mBeamPower[k]});
             }
-            mProcessedTracks[obj->mId].insertTrack(Track{obj->mP, 0, gTimeStamp});
-            return;
         }
     }
-    if (mProcessedTracks.find(obj->mId) != mProcessedTracks.end()) {
-        mProcessedTracks[obj->mId].predictCurrentPosition();
+
+    // An object seen by several sensors is still only one detection, at the strongest return
+    std::sort(mSensedObjects.begin(), mSensedObjects.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first || (a.first == b.first && a.second > b.second);
+    });
+    int previous = -1;
+    mSensedUnique.clear();
+    mRayTargets.clear();
+    mRayUids.clear();
+    for (const auto& sensed : mSensedObjects)
+    {
+        if (sensed.first == previous) {
+            continue;
+        }
+        previous = sensed.first;
+        auto obj = (*mWorldObjects)[sensed.first];
+        mSensedUnique.append(sensed);
+        mRayTargets.append({obj->mP.x(), obj->mP.y()});
+        mRayUids.append(obj->mId);
+    }
+
+    // Only cast rays for what the sensors actually picked up
+    occlusion.computeOcclusion({mParent->mP.x(), mParent->mP.y()}, mParent->mId, mRayTargets, mRayUids, mOccluded);
+    for (int k = 0; k < mSensedUnique.size(); k++)
+    {
+        if (!mOccluded[k]) {
+            mDetections.append({mRayTargets[k], mSensedUnique[k].second});
+        }
     }
+    mPicture->addDetections(mDetections);
+}
+
+float SignalTrackProcessor::nextUniform()
+{
+    // xorshift32, the top 24 bits give a float in [0, 1)
+    mRandomState ^= mRandomState << 13;
+    mRandomState ^= mRandomState >> 17;
+    mRandomState ^= mRandomState << 5;
+    return float(mRandomState >> 8) * (1.0f / 16777216.0f);
 }
@@ -0,0 +1,114 @@
+#include "include/track_associator.h"
+
+
+TrackAssociator::TrackAssociator(qreal gateThreshold, qreal cellSize)
+    : mGateThreshold(gateThreshold), mCellSize(cellSize)
+{
+}
+
+qreal TrackAssociator::getGateRadius(const TrackFilter& filter, int index) const
+{
+    return qSqrt(mGateThreshold * filter.getInnovationVariance(index));
+}
+
+const QVector<int>& TrackAssociator::associate(const TrackFilter& filter, const QVector<Detection>& detections)
+{
+    mAssignment.fill(-1, detections.size());
+    if (filter.size() == 0 || detections.empty()) {
+        return mAssignment;
+    }
+    buildGrid(filter);
+    buildCandidates(filter, detections);
+    auction(filter.size());
+    return mAssignment;
+}
+
+void TrackAssociator::buildGrid(const TrackFilter& filter)
+{
+    mGrid.clear();
+    for (int i = 0; i < filter.size(); i++)
+    {
+        // Insert the track into every cell its gate overlaps, so a detection only checks its own cell
+        QPointF p = filter.getPosition(i);
+        qreal r = getGateRadius(filter, i);
+        for (int cx = cellCoord(p.x() - r); cx <= cellCoord(p.x() + r); cx++) {
+            for (int cy = cellCoord(p.y() - r); cy <= cellCoord(p.y() + r); cy++) {
+                mGrid.append({cellKey(cx, cy), i});
+            }
+        }
+    }
+    std::sort(mGrid.begin(), mGrid.end());
+}
+
+void TrackAssociator::buildCandidates(const TrackFilter& filter, const QVector<Detection>& detections)
+{
+    mCandidates.clear();
+    mCandidateStart.resize(detections.size() + 1);
+    for (int d = 0; d < detections.size(); d++)
+    {
+        mCandidateStart[d] = mCandidates.size();
+        const QPointF& z = detections[d].position;
+        quint64 key = cellKey(cellCoord(z.x()), cellCoord(z.y()));
+        auto cell = std::equal_range(mGrid.cbegin(), mGrid.cend(), QPair<quint64, int>(key, 0),
+                                     [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = cell.first; it != cell.second; it++)
+        {
+            qreal distance = filter.getGateDistance(it->second, z);
+            if (distance <= mGateThreshold) {
+                mCandidates.append({it->second, float(mGateThreshold - distance)});
+            }
+        }
+    }
+    mCandidateStart[detections.size()] = mCandidates.size();
+}
+
+void TrackAssociator::auction(int numTracks)
+{
+    // Each detection also has a private "new track" option with zero benefit
+    const float eps = 1e-3f;
+    int numDetections = mAssignment.size();
+    mPrices.fill(0, numTracks);
+    mOwners.fill(-1, numTracks);
+    mUnassigned.clear();
+    for (int d = numDetections - 1; d >= 0; d--) {
+        if (mCandidateStart[d] != mCandidateStart[d+1]) {
+            mUnassigned.append(d);
+        }
+    }
+
+    while (!mUnassigned.empty())
+    {
+        int d = mUnassigned.takeLast();
+
+        // Find the best and second best value on offer, the new track option is worth zero
+        int bestTrack = -1;
+        float bestValue = 0;
+        float secondValue = 0;
+        for (int c = mCandidateStart[d]; c < mCandidateStart[d+1]; c++)
+        {
+            const auto& candidate = mCandidates[c];
+            float value = candidate.benefit - mPrices[candidate.track];
+            if (value > bestValue) {
+                secondValue = bestValue;
+                bestValue = value;
+                bestTrack = candidate.track;
+            } else if (value > secondValue) {
+                secondValue = value;
+            }
+        }
+        if (bestTrack < 0) {
+            // Outbid everywhere, so the detection starts a new track
+            mAssignment[d] = -1;
+            continue;
+        }
+
+        mPrices[bestTrack] += bestValue - secondValue + eps;
+        int previousOwner = mOwners[bestTrack];
+        if (previousOwner >= 0) {
+            mAssignment[previousOwner] = -1;
+            mUnassigned.append(previousOwner);
+        }
+        mOwners[bestTrack] = d;
+        mAssignment[d] = bestTrack;
+    }
+}
@@ -0,0 +1,152 @@
+#include "include/track_filter.h"
+
+
+TrackFilter::TrackFilter(qreal measurementVar, qreal processVar)
+    : mMeasurementVar(float(measurementVar)), mProcessVar(float(processVar))
+{
+}
+
+int TrackFilter::add(QPointF z)
+{
+    mPosX << float(z.x());
+    mPosY << float(z.y());
+    mVelX << 0;
+    mVelY << 0;
+    mAccX << 0;
+    mAccY << 0;
+
+    // Position is known to the measurement accuracy, the derivatives are not known at all
+    mP00 << mMeasurementVar;
+    mP01 << 0;
+    mP02 << 0;
+    mP11 << 1e4f;
+    mP12 << 0;
+    mP22 << 1.0f;
+
+    mMeasX << float(z.x());
+    mMeasY << float(z.y());
+    mHasMeasurement << 0;
+    return size() - 1;
+}
+
+void TrackFilter::remove(int index)
+{
+    for (auto v : {&mPosX, &mPosY, &mVelX, &mVelY, &mAccX, &mAccY,
+                   &mP00, &mP01, &mP02, &mP11, &mP12, &mP22,
+                   &mMeasX, &mMeasY, &mHasMeasurement})
+    {
+        (*v)[index] = v->last();
+        v->removeLast();
+    }
+}
+
+void TrackFilter::setMeasurement(int index, QPointF z)
+{
+    mMeasX[index] = float(z.x());
+    mMeasY[index] = float(z.y());
+    mHasMeasurement[index] = 1;
+}
+
+void TrackFilter::clearMeasurements()
+{
+    std::fill(mHasMeasurement.begin(), mHasMeasurement.end(), 0.0f);
+}
+
+void TrackFilter::predict()
+{
+    const int n = size();
+    const float q = mProcessVar;
+
+    float* px = mPosX.data();
+    float* py = mPosY.data();
+    float* vx = mVelX.data();
+    float* vy = mVelY.data();
+    const float* ax = mAccX.constData();
+    const float* ay = mAccY.constData();
+    float* p00 = mP00.data();
+    float* p01 = mP01.data();
+    float* p02 = mP02.data();
+    float* p11 = mP11.data();
+    float* p12 = mP12.data();
+    float* p22 = mP22.data();
+
+    // Flat, branch-free loops so the compiler is free to vectorise them
+    for (int i = 0; i < n; i++)
+    {
+        // x' = Fx
+        px[i] += vx[i] + 0.5f*ax[i];
+        py[i] += vy[i] + 0.5f*ay[i];
+        vx[i] += ax[i];
+        vy[i] += ay[i];
+    }
+    for (int i = 0; i < n; i++)
+    {
+        // P' = FPF^T + Q, with Q for white noise jerk over one tick
+        float fp00 = p00[i] + p01[i] + 0.5f*p02[i];
+        float fp01 = p01[i] + p11[i] + 0.5f*p12[i];
+        float fp02 = p02[i] + p12[i] + 0.5f*p22[i];
+        float fp11 = p11[i] + p12[i];
+        float fp12 = p12[i] + p22[i];
+        p00[i] = fp00 + fp01 + 0.5f*fp02 + q*(1.0f/20.0f);
+        p01[i] = fp01 + fp02 + q*(1.0f/8.0f);
+        p02[i] = fp02 + q*(1.0f/6.0f);
+        p11[i] = fp11 + fp12 + q*(1.0f/3.0f);
+        p12[i] = fp12 + q*0.5f;
+        p22[i] += q;
+    }
+}
+
+void TrackFilter::correct()
+{
+    const int n = size();
+    const float r = mMeasurementVar;
+
+    float* px = mPosX.data();
+    float* py = mPosY.data();
+    float* vx = mVelX.data();
+    float* vy = mVelY.data();
+    float* ax = mAccX.data();
+    float* ay = mAccY.data();
+    float* p00 = mP00.data();
+    float* p01 = mP01.data();
+    float* p02 = mP02.data();
+    float* p11 = mP11.data();
+    float* p12 = mP12.data();
+    float* p22 = mP22.data();
+    const float* mx = mMeasX.constData();
+    const float* my = mMeasY.constData();
+    const float* has = mHasMeasurement.constData();
+
+    for (int i = 0; i < n; i++)
+    {
+        // The gain is zeroed for tracks without a measurement
+        float g = has[i] / (p00[i] + r);
+        float k0 = p00[i]*g;
+        float k1 = p01[i]*g;
+        float k2 = p02[i]*g;
+        float innovX = mx[i] - px[i];
+        float innovY = my[i] - py[i];
+
+        px[i] += k0*innovX;
+        py[i] += k0*innovY;
+        vx[i] += k1*innovX;
+        vy[i] += k1*innovY;
+        ax[i] += k2*innovX;
+        ay[i] += k2*innovY;
+
+        // P' = (I - KH)P
+        p22[i] -= k2*p02[i];
+        p12[i] -= k1*p02[i];
+        p11[i] -= k1*p01[i];
+        p02[i] -= k0*p02[i];
+        p01[i] -= k0*p01[i];
+        p00[i] -= k0*p00[i];
+    }
+}
+
+qreal TrackFilter::getGateDistance(int index, QPointF z) const
+{
+    qreal dx = z.x() - mPosX[index];
+    qreal dy = z.y() - mPosY[index];
+    return (dx*dx + dy*dy) / getInnovationVariance(index);
+}
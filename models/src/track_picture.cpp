@@ -0,0 +1,76 @@
+#include "include/track_picture.h"
+
+
+void TrackPicture::addDetections(const QVector<Detection>& detections)
+{
+    if (detections.empty()) {
+        return;
+    }
+    mBatchStart.append(mQueuedDetections.size());
+    mQueuedDetections.append(detections);
+}
+
+void TrackPicture::update()
+{
+    mTrackFilter.predict();
+    dropLostTracks();
+    mUpdatedTracks.clear();
+    for (auto& track : mProcessedTracks) {
+        track.isCurrent = false;
+    }
+
+    for (int b = 0; b < mBatchStart.size(); b++)
+    {
+        int start = mBatchStart[b];
+        int end = (b + 1 < mBatchStart.size()) ? mBatchStart[b+1] : mQueuedDetections.size();
+        mBatch.resize(end - start);
+        std::copy(mQueuedDetections.cbegin() + start, mQueuedDetections.cbegin() + end, mBatch.begin());
+        fuseBatch(mBatch);
+    }
+    mQueuedDetections.clear();
+    mBatchStart.clear();
+
+    for (int i = 0; i < mProcessedTracks.size(); i++) {
+        auto& track = mProcessedTracks.at(i);
+        track.position = mTrackFilter.getPosition(i);
+        track.vel = mTrackFilter.getVelocity(i);
+        track.acc = mTrackFilter.getAcceleration(i);
+    }
+}
+
+void TrackPicture::fuseBatch(const QVector<Detection>& detections)
+{
+    mTrackFilter.clearMeasurements();
+    const auto& assignment = mTrackAssociator.associate(mTrackFilter, detections);
+    for (int d = 0; d < detections.size(); d++)
+    {
+        const auto& detection = detections[d];
+        int index = assignment[d];
+        if (index < 0) {
+            mProcessedTracks.insert(mNextTrackUid++);
+            index = mTrackFilter.add(detection.position);
+        }
+        auto& track = mProcessedTracks.at(index);
+        track.insertTrack(Track{float(detection.position.x()), float(detection.position.y()),
+                                detection.receivedPower, gTimeStamp});
+        track.isCurrent = true;
+        mUpdatedTracks.append(track.uid);
+        mTrackFilter.setMeasurement(index, detection.position);
+    }
+    mTrackFilter.correct();
+}
+
+void TrackPicture::dropLostTracks()
+{
+    // Backwards, as removal moves the last track into the freed index
+    mDroppedTracks.clear();
+    for (int i = mProcessedTracks.size() - 1; i >= 0; i--)
+    {
+        if (mTrackAssociator.getGateRadius(mTrackFilter, i) > sMaxGateRadius)
+        {
+            mDroppedTracks.append(mProcessedTracks.at(i).uid);
+            mProcessedTracks.remove(mProcessedTracks.at(i).uid);
+            mTrackFilter.remove(i);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include "include/track_table.h"
+
+
+TrackTable::TrackTable(int capacity)
+{
+    // Round up to a power of two so the probe can mask rather than mod
+    int size = 2;
+    mShift = 31;
+    while (size < capacity) {
+        size <<= 1;
+        mShift--;
+    }
+    mMask = size - 1;
+    mSlots.fill(Slot(), size);
+    mTracks.reserve(size / 2);
+}
+
+int TrackTable::probe(uint32_t uid) const
+{
+    int i = home(uid);
+    while (mSlots[i].uid != 0 && mSlots[i].uid != uid) {
+        i = (i + 1) & mMask;
+    }
+    return i;
+}
+
+ProcessedTrack* TrackTable::find(uint32_t uid)
+{
+    const Slot& slot = mSlots[probe(uid)];
+    return slot.uid == 0 ? nullptr : &mTracks[slot.index];
+}
+
+const ProcessedTrack* TrackTable::find(uint32_t uid) const
+{
+    const Slot& slot = mSlots[probe(uid)];
+    return slot.uid == 0 ? nullptr : &mTracks[slot.index];
+}
+
+int TrackTable::indexOf(uint32_t uid) const
+{
+    return mSlots[probe(uid)].index;
+}
+
+ProcessedTrack& TrackTable::insert(uint32_t uid)
+{
+    int i = probe(uid);
+    if (mSlots[i].uid == uid) {
+        return mTracks[mSlots[i].index];
+    }
+
+    // Keep the load factor at or below one half
+    if ((mTracks.size() + 1) * 2 > mSlots.size()) {
+        grow();
+        i = probe(uid);
+    }
+    mSlots[i] = Slot{uid, mTracks.size()};
+    mTracks.append(ProcessedTrack{uid});
+    return mTracks.last();
+}
+
+void TrackTable::remove(uint32_t uid)
+{
+    int i = probe(uid);
+    if (mSlots[i].uid == 0) {
+        return;
+    }
+
+    // Move the last track into the hole left in the dense storage
+    int index = mSlots[i].index;
+    int last = mTracks.size() - 1;
+    if (index != last) {
+        mTracks[index] = mTracks[last];
+        mSlots[probe(mTracks[index].uid)].index = index;
+    }
+    mTracks.removeLast();
+
+    // Backward-shift deletion, so no tombstones are needed
+    int j = i;
+    while (true) {
+        j = (j + 1) & mMask;
+        if (mSlots[j].uid == 0) {
+            break;
+        }
+        int k = home(mSlots[j].uid);
+        bool inPlace = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (inPlace) {
+            continue;
+        }
+        mSlots[i] = mSlots[j];
+        i = j;
+    }
+    mSlots[i] = Slot();
+}
+
+void TrackTable::grow()
+{
+    int size = mSlots.size() * 2;
+    mMask = size - 1;
+    mShift--;
+    mSlots.fill(Slot(), size);
+    for (int index = 0; index < mTracks.size(); index++) {
+        int i = probe(mTracks[index].uid);
+        mSlots[i] = Slot{mTracks[index].uid, index};
+    }
+    mTracks.reserve(size / 2);
+}
@@ -6,9 +6,12 @@
 #pragma once
 
 
-class Component : public QObject
+/**
+ * Plain record for a single ship component. Components are held by value in
+ * contiguous storage, geometry is shared between all components of a type.
+ */
+class Component
 {
-    Q_OBJECT
 public:
     enum ComponentType
     {
@@ -21,6 +24,18 @@ public:
 
     Component(ComponentType type, int x, int y, TwoDeg direction = TwoDeg::Up);
 
+    /**
+     * Returns the outline of the given component type, centred on the origin.
+     * Generated once per type and shared by every component.
+     */
+    static const QPolygonF& getShape(ComponentType type);
+
+    /**
+     * Returns the fill texture of the given component type, centred on the origin.
+     * Empty if the component type has no texture.
+     */
+    static const QPolygonF& getTextureShape(ComponentType type);
+
     qreal getNormTemperature() const { return qMin((mTemperature/1000.0)+0.1, 1.0); }
     qreal getHeatInRatio() const { return mHeatInRatio; }
     qreal getHeatOutRatio() const { return mHeatOutRatio; }
@@ -28,9 +43,10 @@ public:
     qreal getTemperature() const { return mTemperature; }
     ComponentType getType() const { return mType; }
     TwoDeg getDirection() const { return mDirection; }
-    QPolygonF getPoly() const { return mPoly; }
-    QPolygonF getTexturePoly() const { return mTexturePoly; }
-    bool isValid() { return mIsValid; }
+    QPointF getScenePos() const;
+    QPolygonF getPoly() const { return getShape(mType).translated(getScenePos()); }
+    QPolygonF getTexturePoly() const { return getTextureShape(mType).translated(getScenePos()); }
+    bool isValid() const { return mIsValid; }
     int x() const { return mX; }
     int y() const { return mY; }
 
@@ -45,9 +61,9 @@ private:
     TwoDeg mDirection;
     qreal mTemperature;
     qreal mMass;
-    QPolygonF mPoly;
-    QPolygonF mTexturePoly;
     qreal mHeatInRatio;
     qreal mHeatOutRatio;
     bool mIsValid = true;
-};
\ No newline at end of file
+};
+
+Q_DECLARE_TYPEINFO(Component, Q_MOVABLE_TYPE);
@@ -5,8 +5,8 @@
 
 class CruiseEngine : public Engine {
 public:
-    CruiseEngine(std::shared_ptr<Component> component, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia);
+    CruiseEngine(int componentIndex, EngineNotifier* notifier, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia);
 };
 
-CruiseEngine::CruiseEngine(std::shared_ptr<Component> component, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia)
-        : Engine(component, direction, centreOfMassOffset, mass, inertia, 15, 0.01, Profile::EXP, Size::BIG) {}
+CruiseEngine::CruiseEngine(int componentIndex, EngineNotifier* notifier, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia)
+        : Engine(componentIndex, notifier, direction, centreOfMassOffset, mass, inertia, 15, 0.01, Profile::EXP, Size::BIG) {}
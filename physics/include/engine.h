@@ -1,14 +1,18 @@
 #include "include/vector.h"
 #include "include/directions.h"
 #include "include/component.h"
+#include "include/engine_notifier.h"
 
 #include <QtWidgets>
 
 #pragma once
 
 
-class Engine : public QObject {
-    Q_OBJECT
+/**
+ * Plain record for a single engine. Engines refer to the component that
+ * houses them by its index in the owning ship's component storage.
+ */
+class Engine {
 public:
     enum Profile {
         EXP,
@@ -19,6 +23,12 @@ public:
         SMALL
     };
 
+    /**
+     * Returns the exhaust polygon for the given engine size and direction,
+     * relative to the engine marker. Generated once and shared by every engine.
+     */
+    static const QPolygonF& getShape(Size size, TwoDeg direction);
+
     bool isForwardAcc() const;
     bool isBackwardAcc() const;
     bool isLateralLeftAcc() const;
@@ -33,24 +43,30 @@ public:
     qreal getMaxRotationalAcc() const;
     qreal getMaxThrust() const { return mDirection == TwoDeg::Up ? mThrust : 0; }
 
-    std::shared_ptr<Component> getComponent() { return mComponent; }
+    int getComponentIndex() const { return mComponentIndex; }
 
     bool enabled() const { return mEnabled; }
 
-    QPolygonF getPoly() const { return mPoly; }
+    const QPolygonF& getShape() const { return getShape(mSize, mDirection); }
+    QPointF getMarker() const { return mMarker; }
+    QPolygonF getPoly() const { return getShape().translated(mMarker); }
     qreal getOpacity() const { return qMax(mThrustRatio, 0.1); }
-    qreal getNormTemperature() const { return mComponent->getNormTemperature(); }
-    void createPoly(QPointF marker);
-
-    void incrementAccProfile();
-    void decrementAccProfile();
+    qreal getThrustRatio() const { return mThrustRatio; }
+    void setMarker(QPointF marker) { mMarker = marker; }
+
+    /**
+     * Ramps the engine up, heating the given housing component.
+     */
+    void incrementAccProfile(Component& component);
+
+    /**
+     * Ramps the engine down, cooling the given housing component.
+     */
+    void decrementAccProfile(Component& component);
     void updateThrustRatio();
 
-Q_SIGNALS:
-    void transmitStatus(const QString&);
-
 protected:
-    Engine(std::shared_ptr<Component> component, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia, qreal thrust, qreal incr, Profile profile, Size size);
+    Engine(int componentIndex, EngineNotifier* notifier, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia, qreal thrust, qreal incr, Profile profile, Size size);
 
     qreal mForwardAcc = 0.0;
     qreal mLateralAcc = 0.0;
@@ -62,9 +78,12 @@ protected:
     Profile mThrustRatioFunction;
     qreal mIncr;
     TwoDeg mDirection;
-    std::shared_ptr<Component> mComponent;
+    int mComponentIndex;
+    EngineNotifier* mNotifier;
 
     bool mEnabled = false;
     Size mSize;
-    QPolygonF mPoly;
-};
\ No newline at end of file
+    QPointF mMarker;
+};
+
+Q_DECLARE_TYPEINFO(Engine, Q_MOVABLE_TYPE);
@@ -0,0 +1,18 @@
+#include <QObject>
+
+#pragma once
+
+
+/**
+ * Relays status messages from the engines of a ship. The engines themselves
+ * are plain records, so they report through a single notifier per ship.
+ */
+class EngineNotifier : public QObject
+{
+    Q_OBJECT
+public:
+    EngineNotifier() : QObject() {}
+
+Q_SIGNALS:
+    void transmitStatus(const QString&);
+};
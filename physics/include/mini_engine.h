@@ -5,8 +5,8 @@
 
 class MiniEngine : public Engine {
 public:
-    MiniEngine(std::shared_ptr<Component> component, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia);
+    MiniEngine(int componentIndex, EngineNotifier* notifier, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia);
 };
 
-MiniEngine::MiniEngine(std::shared_ptr<Component> component, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia)
-        : Engine(component, direction, centreOfMassOffset, mass, inertia, 1, 1.0, Profile::LIN, Size::SMALL) {}
+MiniEngine::MiniEngine(int componentIndex, EngineNotifier* notifier, TwoDeg direction, Vector centreOfMassOffset, qreal mass, qreal inertia)
+        : Engine(componentIndex, notifier, direction, centreOfMassOffset, mass, inertia, 1, 1.0, Profile::LIN, Size::SMALL) {}
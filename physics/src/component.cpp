@@ -2,15 +2,8 @@
 
 
 Component::Component(ComponentType type, int x, int y, TwoDeg direction)
-    : QObject(), mX(x), mY(y), mType(type), mDirection(direction)
+    : mX(x), mY(y), mType(type), mDirection(direction)
 {
-    qreal scenePosX = ((x+0.5) - (gGridSize*0.5)) * gGridSize * 2.0;
-    qreal scenePosY = ((y+0.5) - (gGridSize*0.5)) * gGridSize * 2.0;
-    mPoly = QPolygonF() << QPointF(scenePosX - gGridSceneSize, scenePosY - gGridSceneSize)
-            << QPointF(scenePosX + gGridSceneSize, scenePosY - gGridSceneSize)
-            << QPointF(scenePosX + gGridSceneSize, scenePosY + gGridSceneSize)
-            << QPointF(scenePosX - gGridSceneSize, scenePosY + gGridSceneSize);
-
     switch (type)
     {
         case ComponentType::HeatSink:
@@ -18,10 +11,6 @@ Component::Component(ComponentType type, int x, int y, TwoDeg direction)
             mHeatInRatio = 0.05;
             mHeatOutRatio = 0.01;
             mMass = 100;
-            mTexturePoly << QPointF(scenePosX - (0.6*gGridSceneSize), scenePosY - (0.6*gGridSceneSize))
-                         << QPointF(scenePosX + (0.6*gGridSceneSize), scenePosY - (0.6*gGridSceneSize))
-                         << QPointF(scenePosX + (0.6*gGridSceneSize), scenePosY + (0.6*gGridSceneSize))
-                         << QPointF(scenePosX - (0.6*gGridSceneSize), scenePosY + (0.6*gGridSceneSize));
             break;
         case ComponentType::RotateThruster:
         case ComponentType::CruiseThruster:
@@ -36,14 +25,49 @@ Component::Component(ComponentType type, int x, int y, TwoDeg direction)
             mHeatInRatio = 0.025;
             mHeatOutRatio = 0.025;
             mMass = 100;
-            mTexturePoly << QPointF(scenePosX, scenePosY - (0.6*gGridSceneSize))
-                         << QPointF(scenePosX + (0.6*gGridSceneSize), scenePosY + (0.6*gGridSceneSize))
-                         << QPointF(scenePosX - (0.6*gGridSceneSize), scenePosY + (0.6*gGridSceneSize));
     }
 }
 
+const QPolygonF& Component::getShape(ComponentType type)
+{
+    Q_UNUSED(type);
+    // Every component type currently shares the same outline
+    static const QPolygonF sShape = QPolygonF() << QPointF(-gGridSceneSize, -gGridSceneSize)
+                                                << QPointF(gGridSceneSize, -gGridSceneSize)
+                                                << QPointF(gGridSceneSize, gGridSceneSize)
+                                                << QPointF(-gGridSceneSize, gGridSceneSize);
+    return sShape;
+}
+
+const QPolygonF& Component::getTextureShape(ComponentType type)
+{
+    static const QPolygonF sEmpty;
+    static const QPolygonF sHeatSink = QPolygonF() << QPointF(-(0.6*gGridSceneSize), -(0.6*gGridSceneSize))
+                                                   << QPointF(0.6*gGridSceneSize, -(0.6*gGridSceneSize))
+                                                   << QPointF(0.6*gGridSceneSize, 0.6*gGridSceneSize)
+                                                   << QPointF(-(0.6*gGridSceneSize), 0.6*gGridSceneSize);
+    static const QPolygonF sReactor = QPolygonF() << QPointF(0, -(0.6*gGridSceneSize))
+                                                  << QPointF(0.6*gGridSceneSize, 0.6*gGridSceneSize)
+                                                  << QPointF(-(0.6*gGridSceneSize), 0.6*gGridSceneSize);
+    switch (type)
+    {
+        case ComponentType::HeatSink:
+            return sHeatSink;
+        case ComponentType::Reactor:
+            return sReactor;
+        default:
+            return sEmpty;
+    }
+}
+
+QPointF Component::getScenePos() const
+{
+    return {((mX+0.5) - (gGridSize*0.5)) * gGridSize * 2.0,
+            ((mY+0.5) - (gGridSize*0.5)) * gGridSize * 2.0};
+}
+
 void Component::applyTemperatureDelta(qreal deltaTemp)
 {
     mTemperature += deltaTemp;
     if (mTemperature < 0) mTemperature = 0;
-}
\ No newline at end of file
+}
@@ -1,11 +1,14 @@
 #include "include/engine.h"
 
+#include <array>
 
-Engine::Engine(std::shared_ptr<Component> component, TwoDeg direction, Vector centreOfMassOffset,
+
+Engine::Engine(int componentIndex, EngineNotifier* notifier, TwoDeg direction, Vector centreOfMassOffset,
                qreal mass, qreal inertia, qreal thrust, qreal incr,
                Profile profile, Size size)
 {
-    mComponent = component;
+    mComponentIndex = componentIndex;
+    mNotifier = notifier;
     mDirection = direction;
     mThrust = thrust;
     mIncr = incr;
@@ -91,9 +94,9 @@ qreal Engine::getMaxRotationalAcc() const
     return mRotateAcc;
 }
 
-void Engine::incrementAccProfile()
+void Engine::incrementAccProfile(Component& component)
 {
-    mComponent->applyTemperatureDelta(mThrust*0.5);
+    component.applyTemperatureDelta(mThrust*0.5);
 
     if (mThrustRatioStep < 1) {
         mThrustRatioStep = qMin(mThrustRatioStep + mIncr, 1.0);
@@ -102,9 +105,9 @@ void Engine::incrementAccProfile()
     mEnabled = true;
 }
 
-void Engine::decrementAccProfile()
+void Engine::decrementAccProfile(Component& component)
 {
-    mComponent->applyTemperatureDelta(-mThrust*0.5);
+    component.applyTemperatureDelta(-mThrust*0.5);
 
     if (mThrustRatioStep > 0) {
         mThrustRatioStep = qMax(mThrustRatioStep - mIncr, 0.0);
@@ -114,7 +117,8 @@ void Engine::decrementAccProfile()
     {
         mEnabled = false;
         mThrustRatio = 0;
-        Q_EMIT transmitStatus("THRUSTER SHUTDOWN SUCCESS");
+        if (mNotifier)
+            Q_EMIT mNotifier->transmitStatus("THRUSTER SHUTDOWN SUCCESS");
     }
 }
 
@@ -130,41 +134,41 @@ void Engine::updateThrustRatio()
     }
 }
 
-void Engine::createPoly(QPointF centre)
+const QPolygonF& Engine::getShape(Size size, TwoDeg direction)
 {
-    int height;
-    int minWidth;
-    int maxWidth;
-    switch (mSize)
-    {
-        case BIG:
-            height = 8;
-            minWidth = 2;
-            maxWidth = 4;
-            break;
-        case SMALL:
-            height = -3;
-            minWidth = 2;
-            maxWidth = 1;
-    }
-
-    switch (mDirection)
+    static const auto sShapes = []()
     {
-        case TwoDeg::Up:
-            mPoly << centre + QPointF(-minWidth, 0) << centre + QPointF(-maxWidth, height)
-                  << centre + QPointF(maxWidth, height) << centre + QPointF(minWidth, 0);
-            break;
-        case TwoDeg::Right:
-            mPoly << centre + QPointF(0, -minWidth) << centre + QPointF(-height, -maxWidth)
-                  << centre + QPointF(-height, maxWidth) << centre + QPointF(0, minWidth);
-            break;
-        case TwoDeg::Down:
-            mPoly << centre + QPointF(-minWidth, 0) << centre + QPointF(-maxWidth, -height)
-                  << centre + QPointF(maxWidth, -height) << centre + QPointF(minWidth, 0);
-            break;
-        case TwoDeg::Left:
-            mPoly << centre + QPointF(0, -minWidth) << centre + QPointF(height, -maxWidth)
-                  << centre + QPointF(height, maxWidth) << centre + QPointF(0, minWidth);
-            break;
-    }
-}
\ No newline at end of file
+        // Indexed by [size][direction]
+        std::array<std::array<QPolygonF, 4>, 2> shapes;
+        for (auto s : {Size::BIG, Size::SMALL})
+        {
+            int height;
+            int minWidth;
+            int maxWidth;
+            switch (s)
+            {
+                case BIG:
+                    height = 8;
+                    minWidth = 2;
+                    maxWidth = 4;
+                    break;
+                case SMALL:
+                    height = -3;
+                    minWidth = 2;
+                    maxWidth = 1;
+            }
+
+            auto& poly = shapes[s];
+            poly[int(TwoDeg::Up)] << QPointF(-minWidth, 0) << QPointF(-maxWidth, height)
+                                  << QPointF(maxWidth, height) << QPointF(minWidth, 0);
+            poly[int(TwoDeg::Right)] << QPointF(0, -minWidth) << QPointF(-height, -maxWidth)
+                                     << QPointF(-height, maxWidth) << QPointF(0, minWidth);
+            poly[int(TwoDeg::Down)] << QPointF(-minWidth, 0) << QPointF(-maxWidth, -height)
+                                    << QPointF(maxWidth, -height) << QPointF(minWidth, 0);
+            poly[int(TwoDeg::Left)] << QPointF(0, -minWidth) << QPointF(height, -maxWidth)
+                                    << QPointF(height, maxWidth) << QPointF(0, minWidth);
+        }
+        return shapes;
+    }();
+    return sShapes[size][int(direction)];
+}
@@ -4,17 +4,34 @@
 #pragma once
 
 
+/**
+ * Scrolling map grid.
+ *
+ * The grid is periodic, so one tile of whole cells is rendered into a pixmap at
+ * device resolution and blitted across the exposed area at the scroll offset.
+ * The tile is only re-rendered when the zoom changes.
+ */
 class GridLines : public QGraphicsItem {
 public:
-    GridLines(int spacing) : mOrigin(0, 0), mSpacing(spacing) {}
+    GridLines(int spacing);
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
     QRectF boundingRect() const override;
     void updateOffset(QPointF offset);
 
 private:
+    /**
+     * Renders the tile for the given number of device pixels per scene unit.
+     */
+    void renderTile(qreal scale);
+
+    constexpr static int sMinTilePixels {256}; // Keeps the number of blits down when zoomed out
+
     QPointF mOrigin;
     int mSpacing;
+    QPixmap mTile;
+    qreal mTileScale {0}; // Device pixels per scene unit the tile was rendered at
+    qreal mTileSize {0}; // Scene units, a whole number of grid cells
     const qreal mMinX {-2000};
     const qreal mMinY {-1500};
     const qreal mWidth {abs(mMinX)*2};
@@ -7,9 +7,22 @@
 #pragma once
 
 
+/**
+ * Coverage of one sensor on the strategic map.
+ *
+ * The FOV wedge is fixed in the sensor's own frame, so it is rendered once per
+ * zoom into a pixmap and blitted rotated to the bore angle, leaving only the scan
+ * wedge to be drawn each frame. The pixmap's resolution is capped, so a wide
+ * wedge is rendered smaller and scaled up. Only when zoomed in so far that the
+ * scaling would show is the wedge drawn directly instead.
+ */
 class SensorFOV : public QGraphicsItem {
 public:
-    SensorFOV(qreal leftFOV, qreal rightFOV, qreal scanFOV) : mLeftFOV(leftFOV), mRightFOV(rightFOV), mTotalFOV(leftFOV + rightFOV), mScanFOV(scanFOV) {}
+    SensorFOV(qreal leftFOV, qreal rightFOV, qreal scanFOV) : mLeftFOV(leftFOV), mRightFOV(rightFOV), mTotalFOV(leftFOV + rightFOV), mScanFOV(scanFOV)
+    {
+        mWedgeRect = fitWedge(0);
+        computeBounds();
+    }
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
     QRectF boundingRect() const override;
@@ -17,6 +30,30 @@ public:
     void updateScan(QPointF pos, qreal boreAngle, bool isActive = false);
 
 private:
+    /**
+     * Returns the bounds of the FOV wedge at the given bore angle, including the pen.
+     */
+    QRectF fitWedge(qreal boreAngle) const;
+
+    /**
+     * Fits the bounding rect to the FOV wedge at the current bore angle.
+     */
+    void computeBounds() { mBounds = fitWedge(mBoreAngle); }
+
+    /**
+     * Draws the FOV wedge at the zero bore angle.
+     */
+    void drawFOV(QPainter* painter) const;
+
+    /**
+     * Renders the FOV wedge for the given number of device pixels per scene unit.
+     */
+    void renderFOV(qreal scale);
+
+    constexpr static qreal sRadius {600};
+    constexpr static int sMaxPixmapSize {1024}; // Device pixels per side, larger wedges are rendered at a lower scale
+    constexpr static qreal sMaxUpscale {2}; // Beyond this much scaling up of the pixmap, the wedge is drawn directly
+
     qreal mLeftFOV;
     qreal mRightFOV;
     qreal mTotalFOV;
@@ -24,4 +61,8 @@ private:
     qreal mBoreAngle = 0;
     qreal mScanAngle = 0;
     bool mIsActive = true;
+    QRectF mBounds;
+    QRectF mWedgeRect; // Bounds of the FOV wedge at the zero bore angle
+    QPixmap mFOVPixmap; // Covers mWedgeRect, null until first painted
+    qreal mFOVScale {0}; // Device pixels per scene unit the pixmap was rendered at
 };
\ No newline at end of file
@@ -24,10 +24,25 @@ public:
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
     QRectF boundingRect() const override;
-    void updateTrack(qreal x, qreal y, Vector velocity, Faction perceivedFaction, bool isCurrent);
+    void updateTrack(qreal x, qreal y, QPointF velocity, Faction perceivedFaction, bool isCurrent);
     void updateOffset(QPointF offset);
+    const QColor& getColour() const { return mColour; }
+
+    /**
+     * Returns true once the track has not been updated for the symbol's whole lifetime.
+     */
+    bool isExpired() const { return mLifetime == 0; }
+
+    /**
+     * Returns the symbol to its initial state, so it can be reused for another track.
+     */
+    void reset();
 
 private:
+    // Below these sizes on screen the detail is unreadable, so is not drawn
+    constexpr static qreal sMinLeaderPixels {4};
+    constexpr static qreal sMinDetailPixels {6};
+
     QPolygonF mPoly;
     QLineF mVelLine {0, 0, 0, 0};
     Faction mPerceivedFaction {Faction::Unknown};
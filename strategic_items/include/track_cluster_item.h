@@ -0,0 +1,48 @@
+#include <QGraphicsItem>
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * An aggregate of tracks that are too close together on screen to draw separately.
+ */
+struct TrackCluster
+{
+    QPointF position; // Centroid of the tracks
+    int count;
+    QColor colour;
+};
+
+Q_DECLARE_TYPEINFO(TrackCluster, Q_MOVABLE_TYPE);
+
+/**
+ * Draws every track cluster on the strategic map in a single item.
+ *
+ * Clusters are drawn at a fixed size on screen, labelled with the number
+ * of tracks they hold, whatever the zoom of the map.
+ */
+class TrackClusterItem : public QGraphicsItem
+{
+public:
+    TrackClusterItem();
+    enum { Type = 8 };
+    int type() const override { return Type; }
+
+    /**
+     * Replaces the clusters to draw.
+     * @param clusters - The clusters, in scene coordinates.
+     * @param zoom - The scale of the view, i.e. pixels per scene unit.
+     */
+    void setClusters(const QVector<TrackCluster>& clusters, qreal zoom);
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+    QRectF boundingRect() const override { return mBounds; }
+
+private:
+    constexpr static qreal sHalfSize {12}; // Pixels
+
+    QVector<TrackCluster> mClusters;
+    qreal mExtent {0}; // Half size of a cluster symbol in scene units
+    QRectF mBounds;
+};
@@ -5,7 +5,6 @@ void AccelerationMarker::updateOffset(Vector vel, Vector acc)
 {
     mOrigin = (vel * mSeconds) + (acc * mSeconds * mSeconds * 0.5);
     setPos(mOrigin.getSize() * qSin(mOrigin.getAtan2()), -mOrigin.getSize() * qCos(mOrigin.getAtan2()));
-    prepareGeometryChange();
 }
 
 void AccelerationMarker::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -20,5 +19,6 @@ void AccelerationMarker::paint(QPainter *painter, const QStyleOptionGraphicsItem
 
 QRectF AccelerationMarker::boundingRect() const
 {
-    return {-20, -20, 40, 40};
+    // Circle plus half the pen and a pixel for antialiasing
+    return {-mSize - 1.5, -mSize - 1.5, mSize*2 + 3.0, mSize*2 + 3.0};
 }
\ No newline at end of file
@@ -1,38 +1,77 @@
 #include "include/grid_lines.h"
 
+
+GridLines::GridLines(int spacing) : mOrigin(0, 0), mSpacing(spacing)
+{
+    // Only the exposed part of the grid is blitted
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
 void GridLines::updateOffset(QPointF offset)
 {
+    if (offset.isNull()) {
+        return;
+    }
     mOrigin += offset;
-    prepareGeometryChange();
+    update();
 }
 
-void GridLines::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+void GridLines::renderTile(qreal scale)
 {
-    int xOffset = (int)mOrigin.x();
-    int yOffset = (int)mOrigin.y();
-    int sceneInitX = (int)mMinX + (int)(mOrigin.x()) % mSpacing;
-    int sceneInitY = (int)mMinY + (int)(mOrigin.y()) % mSpacing;
-    int sceneX = sceneInitX;
-    int sceneY = sceneInitY;
-    qreal remX = mOrigin.x() - xOffset;
-    qreal remY = mOrigin.y() - yOffset;
+    int cells = qMax(1, qCeil(sMinTilePixels / (mSpacing * scale)));
+    mTileSize = cells * mSpacing;
+    mTileScale = scale;
+    int pixels = qCeil(mTileSize * scale);
+    mTile = QPixmap(pixels, pixels);
+    mTile.fill(Qt::transparent);
 
+    QPainter painter(&mTile);
+    painter.scale(pixels / mTileSize, pixels / mTileSize);
     QPen pen;
     pen.setColor(QColor(0, 255, 0, 25));
     pen.setWidthF(2.0);
-    painter->setPen(pen);
-    painter->setRenderHint(QPainter::Antialiasing);
+    painter.setPen(pen);
+    painter.setRenderHint(QPainter::Antialiasing);
 
-    for (int x = xOffset; x < xOffset + mWidth; x += mSpacing)
+    // Lines run through the middle of each cell, so none are clipped at the tile edge
+    for (int i = 0; i < cells; i++)
     {
-        painter->drawLine(QLineF(sceneX+remX, mMinY, sceneX+remX, mMinY+mHeight));
-        sceneX += mSpacing;
+        qreal p = (i + 0.5) * mSpacing;
+        painter.drawLine(QLineF(p, 0, p, mTileSize));
+        painter.drawLine(QLineF(0, p, mTileSize, p));
+    }
+    painter.end();
+}
+
+void GridLines::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (scale != mTileScale) {
+        renderTile(scale);
     }
-    for (int y = yOffset; y < yOffset + mHeight; y += mSpacing)
+
+    // Lines lie on the origin plus a whole number of cells, tiles start half a cell before one
+    QPointF tileOrigin(mMinX + std::fmod(mOrigin.x(), mSpacing) - mSpacing*0.5,
+                       mMinY + std::fmod(mOrigin.y(), mSpacing) - mSpacing*0.5);
+    QRectF exposed = option->exposedRect.intersected(boundingRect());
+    int txStart = qFloor((exposed.left() - tileOrigin.x()) / mTileSize);
+    int txEnd = qFloor((exposed.right() - tileOrigin.x()) / mTileSize);
+    int tyStart = qFloor((exposed.top() - tileOrigin.y()) / mTileSize);
+    int tyEnd = qFloor((exposed.bottom() - tileOrigin.y()) / mTileSize);
+
+    painter->save();
+    painter->setClipRect(boundingRect());
+    for (int tx = txStart; tx <= txEnd; tx++)
     {
-        painter->drawLine(QLineF(mMinX, sceneY+remY, mMinX+mWidth, sceneY+remY));
-        sceneY += mSpacing;
+        for (int ty = tyStart; ty <= tyEnd; ty++)
+        {
+            QRectF target(tileOrigin.x() + tx*mTileSize, tileOrigin.y() + ty*mTileSize, mTileSize, mTileSize);
+            painter->drawPixmap(target, mTile, mTile.rect());
+        }
     }
+    painter->restore();
 }
 
 QRectF GridLines::boundingRect() const
@@ -6,12 +6,17 @@ PlayerSymbolItem::PlayerSymbolItem(QPointF pos) : mVelocity(0, 0), mAtan2(0)
 
 void PlayerSymbolItem::applyUpdate(qreal angle)
 {
-    mAtan2 = angle - 0.5*M_PI;
+    // Nothing to repaint unless the ship has turned
+    Bearing atan2(angle - 0.5*M_PI);
+    if (!mPoly.empty() && atan2() == mAtan2()) {
+        return;
+    }
+    mAtan2 = atan2;
     mPoly.clear();
     mPoly << QPointF(qCos(mAtan2())*mHalfLength, qSin(mAtan2())*mHalfLength)
           << QPointF(qCos(mAtan2 + M_PI - 0.5)*mHalfLength, qSin(mAtan2 + M_PI - 0.5)*mHalfLength)
           << QPointF(qCos(mAtan2 + M_PI + 0.5)*mHalfLength, qSin(mAtan2 + M_PI + 0.5)*mHalfLength);
-    prepareGeometryChange();
+    update();
 }
 
 void PlayerSymbolItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -27,5 +32,6 @@ void PlayerSymbolItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
 
 QRectF PlayerSymbolItem::boundingRect() const
 {
-    return {-mHalfLength, -mHalfLength, mHalfLength * 2, mHalfLength * 2};
+    // The symbol rotates within this, plus a pixel for antialiasing
+    return {-mHalfLength - 1, -mHalfLength - 1, mHalfLength * 2 + 2, mHalfLength * 2 + 2};
 }
@@ -3,35 +3,121 @@
 
 void SensorFOV::updateScan(QPointF pos, qreal boreAngle, qreal scanAngle)
 {
-    mBoreAngle = boreAngle;
+    if (boreAngle != mBoreAngle)
+    {
+        prepareGeometryChange();
+        mBoreAngle = boreAngle;
+        computeBounds();
+    }
+    else if (scanAngle != mScanAngle || !mIsActive)
+    {
+        update();
+    }
     mScanAngle = scanAngle;
     mIsActive = true;
     setPos(pos * gScaleFactor);
-    prepareGeometryChange();
 }
 
 void SensorFOV::updateScan(QPointF pos, qreal boreAngle, bool isActive)
 {
-    mBoreAngle = boreAngle;
+    if (boreAngle != mBoreAngle)
+    {
+        prepareGeometryChange();
+        mBoreAngle = boreAngle;
+        computeBounds();
+    }
+    else if (isActive != mIsActive)
+    {
+        update();
+    }
     mIsActive = isActive;
     setPos(pos * gScaleFactor);
-    prepareGeometryChange();
 }
 
-void SensorFOV::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+QRectF SensorFOV::fitWedge(qreal boreAngle) const
+{
+    // The scan wedge always lies within the FOV wedge, so only the FOV wedge is fitted
+    QRectF bounds;
+    if (mTotalFOV >= 2.0*M_PI)
+    {
+        bounds = QRectF(-sRadius, -sRadius, sRadius*2, sRadius*2);
+    }
+    else
+    {
+        // Counter-clockwise angles (y up) as used by drawPie, the wedge runs clockwise from the start
+        qreal start = (M_PI * 0.5) - boreAngle + mLeftFOV;
+        qreal end = start - mTotalFOV;
+        auto arcPoint = [](qreal a) { return QPointF(sRadius * qCos(a), -sRadius * qSin(a)); };
+
+        QPolygonF hull;
+        hull << QPointF(0, 0) << arcPoint(start) << arcPoint(end);
+        // Include every axis extreme the arc passes through
+        for (int k = qCeil(end / (M_PI * 0.5)); k * M_PI * 0.5 <= start; k++) {
+            hull << arcPoint(k * M_PI * 0.5);
+        }
+        bounds = hull.boundingRect();
+    }
+    // Half the pen width plus a pixel for antialiasing
+    return bounds.adjusted(-2, -2, 2, 2);
+}
+
+void SensorFOV::drawFOV(QPainter* painter) const
 {
-    int fovAngle16Start = int(((M_PI * 0.5) - mBoreAngle + mLeftFOV) * 5760 / (2 * M_PI));
+    int fovAngle16Start = int(((M_PI * 0.5) + mLeftFOV) * 5760 / (2 * M_PI));
     int fovAngle16Width = -int((mTotalFOV) * 5760 / (2 * M_PI));
 
     QPen pen;
     pen.setColor(QColor(0, 255, 0, 50));
     pen.setWidthF(2.0);
     painter->setPen(pen);
+    painter->setBrush(Qt::NoBrush);
     painter->setRenderHint(QPainter::Antialiasing);
-    painter->drawPie(QRectF(-600, -600, 1200, 1200), fovAngle16Start, fovAngle16Width);
+    painter->drawPie(QRectF(-sRadius, -sRadius, sRadius*2, sRadius*2), fovAngle16Start, fovAngle16Width);
+}
+
+void SensorFOV::renderFOV(qreal scale)
+{
+    mFOVScale = scale;
+    mFOVPixmap = QPixmap(qCeil(mWedgeRect.width() * scale), qCeil(mWedgeRect.height() * scale));
+    mFOVPixmap.fill(Qt::transparent);
+
+    QPainter painter(&mFOVPixmap);
+    painter.scale(scale, scale);
+    painter.translate(-mWedgeRect.topLeft());
+    drawFOV(&painter);
+    painter.end();
+}
+
+void SensorFOV::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    // The wedge is drawn in the sensor's frame, rotated to the bore
+    qreal degrees = mBoreAngle*360.0/(M_PI*2.0);
+    painter->rotate(degrees);
+    qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    qreal pixmapScale = qMin(scale, sMaxPixmapSize / qMax(mWedgeRect.width(), mWedgeRect.height()));
+    if (scale > pixmapScale * sMaxUpscale)
+    {
+        drawFOV(painter);
+    }
+    else
+    {
+        if (mFOVPixmap.isNull() || pixmapScale != mFOVScale) {
+            renderFOV(pixmapScale);
+        }
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+        painter->drawPixmap(mWedgeRect, mFOVPixmap, mFOVPixmap.rect());
+    }
+    painter->rotate(-degrees);
 
     if (!mIsActive)
         return;
+
+    QPen pen;
+    pen.setColor(QColor(0, 255, 0, 50));
+    pen.setWidthF(2.0);
+    painter->setPen(pen);
+    painter->setRenderHint(QPainter::Antialiasing);
+
     int scanAngle16Start = int(((M_PI * 0.5) - mBoreAngle - mScanAngle + mScanFOV) * 5760 / (2 * M_PI));
     int scanAngle16Width = -int((mScanFOV*2) * 5760 / (2 * M_PI));
 
@@ -39,10 +125,10 @@ void SensorFOV::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
     brush.setStyle(Qt::BrushStyle::SolidPattern);
     brush.setColor(QColor(0, 255, 0, 25));
     painter->setBrush(brush);
-    painter->drawPie(QRectF(-600, -600, 1200, 1200), scanAngle16Start, scanAngle16Width);
+    painter->drawPie(QRectF(-sRadius, -sRadius, sRadius*2, sRadius*2), scanAngle16Start, scanAngle16Width);
 }
 
 QRectF SensorFOV::boundingRect() const
 {
-    return {-600, -600, 1200, 1200};
+    return mBounds;
 }
\ No newline at end of file
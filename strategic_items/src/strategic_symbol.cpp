@@ -5,30 +5,37 @@ void StrategicSymbol::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
 
     Q_UNUSED(widget);
 
+    qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    bool detailed = mSize*lod >= sMinDetailPixels;
+
     QPen pen;
     pen.setColor(mColour);
     pen.setWidthF(2.0);
-    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::Antialiasing, detailed);
     painter->setPen(pen);
 
-    if (mIsCurrent) {
+    if (detailed && mIsCurrent) {
         painter->drawRect(QRectF(-mSize, -mSize, mSize*2.0, mSize*2.0));
     }
-    if (mDrawBox) {
+    if (detailed && mDrawBox) {
         painter->drawRect(QRectF((-mSize)-4, (-mSize)-4, (mSize+4)*2.0, (mSize+4)*2.0));
     }
     painter->drawPolygon(mPoly);
 
-    painter->drawLine(mVelLine);
+    if (mVelLine.length()*lod >= sMinLeaderPixels) {
+        painter->drawLine(mVelLine);
+    }
 }
 
 QRectF StrategicSymbol::boundingRect() const
 {
-    // Making the bounding rect too big helps with rendering fast moving Asteroids
-    return {-mSize*2, -mSize*2, mSize*4.0, mSize*4.0};
+    // Outer box plus half the pen and a pixel for antialiasing, and the velocity line
+    qreal extent = mSize + 4 + 2;
+    QRectF box(-extent, -extent, extent*2.0, extent*2.0);
+    return box.united(QRectF(mVelLine.p1(), mVelLine.p2()).normalized().adjusted(-2, -2, 2, 2));
 }
 
-void StrategicSymbol::updateTrack(qreal x, qreal y, Vector velocity, Faction perceivedFaction, bool isCurrent)
+void StrategicSymbol::updateTrack(qreal x, qreal y, QPointF velocity, Faction perceivedFaction, bool isCurrent)
 {
     // Animation
     if (mLifetime == 0) {
@@ -36,24 +43,54 @@ void StrategicSymbol::updateTrack(qreal x, qreal y, Vector velocity, Faction per
     }
     mIsCurrent = isCurrent;
 
-    mVelLine = QLineF(0, 0, velocity.x(), velocity.y());
+    QLineF velLine(0, 0, velocity.x(), velocity.y());
+    if (velLine != mVelLine) {
+        prepareGeometryChange();
+        mVelLine = velLine;
+    }
 
     mLifetime = mMaxLifetime;
     setPos(x, y);
     switch (perceivedFaction) {
-        case Faction::Red: mColour = QColor(255, 0, 0);
-        case Faction::Blue: mColour = QColor(0, 0, 255);
-        case Faction::Green: mColour = QColor(0, 255, 0);
-        case Faction::Unknown: mColour = QColor(255, 155, 0);
+        case Faction::Red: mColour = QColor(255, 0, 0); break;
+        case Faction::Blue: mColour = QColor(0, 0, 255); break;
+        case Faction::Green: mColour = QColor(0, 255, 0); break;
+        case Faction::Unknown: mColour = QColor(255, 155, 0); break;
     }
 }
 
+void StrategicSymbol::reset()
+{
+    if (!mVelLine.isNull()) {
+        prepareGeometryChange();
+        mVelLine = QLineF(0, 0, 0, 0);
+    }
+    mLifetime = 0;
+    mAnimationLifetime = 0;
+    mDrawBox = false;
+    mIsCurrent = false;
+}
+
 void StrategicSymbol::updateOffset(QPointF offset)
 {
-    setPos(pos() + offset);
+    if (!offset.isNull()) {
+        setPos(pos() + offset);
+    }
     if (mLifetime > 0) mLifetime--;
     if (mAnimationLifetime > 0) mAnimationLifetime--;
-    if (mAnimationLifetime > 0 && mAnimationLifetime % 25 == 0) mDrawBox = !mDrawBox;
+    bool changed = false;
+    if (mAnimationLifetime > 0 && mAnimationLifetime % 25 == 0) {
+        mDrawBox = !mDrawBox;
+        changed = true;
+    }
 
-    mColour.setAlpha(qMax((205*mLifetime/mMaxLifetime) + 50, 0));
+    int alpha = qMax((205*mLifetime/mMaxLifetime) + 50, 0);
+    if (alpha != mColour.alpha()) {
+        mColour.setAlpha(alpha);
+        changed = true;
+    }
+    // Only repaint when the symbol looks different
+    if (changed) {
+        update();
+    }
 }
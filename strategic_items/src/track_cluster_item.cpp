@@ -0,0 +1,71 @@
+#include "include/track_cluster_item.h"
+
+
+TrackClusterItem::TrackClusterItem()
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void TrackClusterItem::setClusters(const QVector<TrackCluster>& clusters, qreal zoom)
+{
+    mClusters = clusters;
+    // Half the symbol plus the pen and a pixel for antialiasing
+    mExtent = (sHalfSize + 2) / zoom;
+
+    QRectF bounds;
+    if (!mClusters.empty())
+    {
+        qreal left = mClusters[0].position.x();
+        qreal right = left;
+        qreal top = mClusters[0].position.y();
+        qreal bottom = top;
+        for (const auto& c : mClusters)
+        {
+            left = qMin(left, c.position.x());
+            right = qMax(right, c.position.x());
+            top = qMin(top, c.position.y());
+            bottom = qMax(bottom, c.position.y());
+        }
+        bounds = QRectF(left, top, right - left, bottom - top).adjusted(-mExtent, -mExtent, mExtent, mExtent);
+    }
+    if (bounds != mBounds)
+    {
+        prepareGeometryChange();
+        mBounds = bounds;
+    }
+    update();
+}
+
+void TrackClusterItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    QRectF visible = option->exposedRect.adjusted(-mExtent, -mExtent, mExtent, mExtent);
+    QRectF box(-sHalfSize, -sHalfSize, sHalfSize*2.0, sHalfSize*2.0);
+
+    QFont font = painter->font();
+    font.setPixelSize(int(sHalfSize));
+    painter->setFont(font);
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setBrush(Qt::NoBrush);
+
+    QPen pen;
+    pen.setWidthF(2.0);
+    for (const auto& c : mClusters)
+    {
+        if (!visible.contains(c.position)) {
+            continue;
+        }
+        pen.setColor(c.colour);
+        painter->setPen(pen);
+
+        // Draw in pixels around the centroid, so the symbol stays legible at any zoom
+        painter->save();
+        painter->translate(c.position);
+        painter->scale(1.0/lod, 1.0/lod);
+        painter->drawRect(box);
+        painter->drawText(box, Qt::AlignCenter, QString::number(c.count));
+        painter->restore();
+    }
+}
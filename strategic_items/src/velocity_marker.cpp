@@ -5,7 +5,6 @@ void VelocityMarker::updateOffset(Vector vel)
 {
     mOrigin = vel * mSeconds;
     setPos(mOrigin.getSize() * qSin(mOrigin.getAtan2()), -mOrigin.getSize() * qCos(mOrigin.getAtan2()));
-    prepareGeometryChange();
 }
 
 void VelocityMarker::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -20,5 +19,6 @@ void VelocityMarker::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
 
 QRectF VelocityMarker::boundingRect() const
 {
-    return {-20, -20, 40, 40};
+    // Circle plus half the pen and a pixel for antialiasing
+    return {-mSize - 1.5, -mSize - 1.5, mSize*2 + 3.0, mSize*2 + 3.0};
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <QGraphicsItem>
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Draws every missile in the scene in a single paint call.
+ *
+ * Missiles only report their position and bearing, the outlines are generated
+ * from a prebuilt template into one line array (skipping missiles outside the
+ * exposed rect) and drawn with a single pen. The item spans every missile, but
+ * each tick only the missiles that changed are repainted.
+ */
+class MissileBatchItem : public QGraphicsItem
+{
+public:
+    MissileBatchItem();
+    enum { Type = 7 };
+    int type() const override { return Type; }
+
+    /**
+     * Adds a missile to the batch.
+     * @return The index of the missile within the batch.
+     */
+    int addMissile(QPointF pos, qreal atan2);
+
+    /**
+     * Removes the missile at the given index. The last missile is moved into
+     * its place, so its index changes to the removed one.
+     */
+    void removeMissile(int index);
+
+    /**
+     * Sets the position and bearing (rads) of the missile, applied on the next sync().
+     */
+    void setMissile(int index, QPointF pos, qreal atan2)
+    {
+        mPositions[index] = pos;
+        mBearings[index] = atan2;
+    }
+
+    /**
+     * Recomputes the bounds of the batch and schedules a repaint of each missile that
+     * changed since the last sync, once per tick.
+     * @param visible - The area on screen, in scene coordinates. Changes outside it are not repainted.
+     */
+    void sync(const QRectF& visible);
+
+    int size() const { return mPositions.size(); }
+
+    /**
+     * Collects the bounds of each missile that overlaps the given area.
+     * @param visible - The area of interest, in scene coordinates.
+     * @param rects - Output, cleared first.
+     */
+    void getMissileRects(const QRectF& visible, QVector<QRectF>& rects) const;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+    QRectF boundingRect() const override { return mBounds; }
+
+private:
+    constexpr static qreal sLength = 25;
+    constexpr static qreal sWidth = 5;
+    constexpr static qreal sExtent = sLength + 2*sWidth; // Furthest any vertex is from the centre
+    constexpr static qreal sBoundsMargin = 1000; // Slack around the missiles before the bounds are refitted
+
+    static const QVector<QLineF>& getTemplate();
+
+    static QRectF getMissileRect(QPointF pos)
+    {
+        return QRectF(pos.x() - sExtent, pos.y() - sExtent, sExtent*2.0, sExtent*2.0);
+    }
+
+    QVector<QPointF> mPositions;
+    QVector<qreal> mBearings;
+    QRectF mBounds;
+    QVector<QPointF> mSyncedPositions; // As of the last sync(), so the area a missile left is repainted
+    QVector<qreal> mSyncedBearings;
+    QVector<QLineF> mLines; // Reused between paints
+};
@@ -1,4 +1,3 @@
-#include "blur.h"
 #include "include/engine.h"
 #include "include/component.h"
 
@@ -8,22 +7,58 @@
 #pragma once
 
 
+/**
+ * Tactical view of the player ship.
+ *
+ * The ship is rendered unrotated into a cached sprite and drawn as one rotated
+ * blit. Temperatures and engine opacities are quantised into colour buckets, so
+ * the sprite is only rebuilt when the ship is reconfigured, a bucket changes or
+ * the view is zoomed.
+ */
 class PlayerShipItem : public QGraphicsItem {
 public:
-    PlayerShipItem(Bearing& angle) : mAtan2(angle) {};
+    PlayerShipItem() = default;
     enum { Type = 1 };
     int type() const override { return Type; }
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
     QRectF boundingRect() const override;
-    void update() { prepareGeometryChange(); }
 
-    void addEngine(std::shared_ptr<Engine> engine) { mEngines.push_back(engine); }
-    void addComponent(std::shared_ptr<Component> component) { mComponents.push_back(component); }
-    void reset();
+    /**
+     * Sets the ship state to draw, copied from a render snapshot rather than
+     * referenced, since the simulation keeps updating its own state meanwhile.
+     * @param revision - Configuration revision of the ship, changes whenever it is reconfigured.
+     */
+    void setShip(Bearing angle, const QVector<Component>& components, const QVector<Engine>& engines, uint32_t revision);
 
 private:
-    Bearing& mAtan2;
-    QVector<std::shared_ptr<Engine>> mEngines;
-    QVector<std::shared_ptr<Component>> mComponents;
-};
\ No newline at end of file
+    /**
+     * Recomputes the bounds and sprite rect from the current components and engines.
+     */
+    void updateBounds();
+
+    /**
+     * Renders the sprite for the given number of device pixels per scene unit.
+     */
+    void renderSprite(qreal scale);
+
+    /**
+     * Returns the colour bucket of a normalised temperature or opacity.
+     */
+    static int getBucket(qreal value) { return qBound(0, int(value * sBuckets), sBuckets - 1); }
+    static QColor getBucketColour(int bucket) { return {0, 255 * bucket / (sBuckets - 1), 0}; }
+
+    constexpr static int sBuckets {16};
+
+    qreal mRadius {0}; // The item rotates, so the bounds are a square around the furthest point
+    Bearing mAtan2 {0};
+    QVector<Component> mComponents;
+    QVector<Engine> mEngines;
+    uint32_t mRevision {0};
+
+    QVector<quint8> mBuckets; // Per component temperature, then per engine opacity
+    QVector<quint8> mNextBuckets;
+    QPixmap mSprite; // Null when out of date
+    QRectF mSpriteRect; // Unrotated extent of the ship
+    qreal mSpriteScale {0}; // Device pixels per scene unit the sprite was rendered at
+};
@@ -4,10 +4,17 @@
 #pragma once
 
 
+/**
+ * Procedurally generated parallax star layer.
+ *
+ * Stars sit on a fixed lattice in layer space and are rendered once into cached
+ * pixmap tiles (keyed by tile coordinate), so scrolling the layer is just blitting
+ * the visible tiles at an offset. Tiles are generated as they come into view and
+ * the motion streaks are drawn over the tiles in a single pass.
+ */
 class Starfield : public QGraphicsItem {
 public:
-    Starfield(QPointF origin, qreal scale, int densityFactor)
-            : mOrigin(origin), mScaleFactor(scale), mDensityFactor(densityFactor) {}
+    Starfield(QPointF origin, qreal scale, int densityFactor);
 
     /**
      * Fast PRNG. Nicked from: https://en.wikipedia.org/wiki/Lehmer_random_number_generator
@@ -20,8 +27,33 @@ public:
     void updateOffset(QPointF offset);
 
 private:
+    struct Tile
+    {
+        QPixmap pixmap;
+        QVector<QPointF> stars; // Layer space
+    };
+
+    /**
+     * Returns true if there is a star at the given lattice point (layer space).
+     */
+    static bool hasStar(int u, int v);
+
+    /**
+     * Returns the cached tile at the given tile coordinate, generating it if needed.
+     */
+    const Tile& getTile(int tx, int ty);
+
+    quint64 tileKey(int tx, int ty) const { return (quint64(quint32(tx)) << 32) | quint32(ty); }
+
+    constexpr static int sTileSize {256};
+    constexpr static int sMaxTiles {128};
+
     QPointF mOrigin;
     QPointF mLastOffset;
     qreal mScaleFactor;
     int mDensityFactor;
+
+    QHash<quint64, Tile> mTiles;
+    qreal mTileScale {0}; // Device pixels per layer unit the cached tiles were rendered at
+    QVector<QLineF> mStreaks;
 };
@@ -63,8 +63,8 @@ void Asteroid::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 
 QRectF Asteroid::boundingRect() const
 {
-    // Making the bounding rect too big helps with rendering fast moving Asteroids
-    return QRectF(-mR*2, -mR*2, mR*4.0, mR*4.0);
+    // Circle plus half the pen and a pixel for antialiasing
+    return QRectF(-mR - 1.5, -mR - 1.5, mR*2.0 + 3.0, mR*2.0 + 3.0);
 }
 
 qreal Asteroid::distance(Asteroid* b) const
@@ -0,0 +1,134 @@
+#include "include/missile_batch_item.h"
+
+
+MissileBatchItem::MissileBatchItem()
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+const QVector<QLineF>& MissileBatchItem::getTemplate()
+{
+    // Body and tail outlines, pointing along the zero bearing
+    static const QVector<QLineF> sTemplate = [] {
+        QPolygonF body(QRectF(-sWidth, -sLength, sWidth*2.0, sLength*2.0));
+        QPolygonF tail(QRectF(-sWidth, sLength, sWidth*2.0, sWidth*2.0));
+        QVector<QLineF> lines;
+        for (const auto& poly : {body, tail}) {
+            for (int i = 0; i + 1 < poly.size(); i++) {
+                lines << QLineF(poly[i], poly[i + 1]);
+            }
+        }
+        return lines;
+    }();
+    return sTemplate;
+}
+
+int MissileBatchItem::addMissile(QPointF pos, qreal atan2)
+{
+    mPositions << pos;
+    mBearings << atan2;
+    return mPositions.size() - 1;
+}
+
+void MissileBatchItem::removeMissile(int index)
+{
+    mPositions[index] = mPositions.last();
+    mBearings[index] = mBearings.last();
+    mPositions.removeLast();
+    mBearings.removeLast();
+}
+
+void MissileBatchItem::sync(const QRectF& visible)
+{
+    QRectF bounds;
+    if (!mPositions.empty())
+    {
+        qreal left = mPositions[0].x();
+        qreal right = left;
+        qreal top = mPositions[0].y();
+        qreal bottom = top;
+        for (const auto& p : mPositions)
+        {
+            left = qMin(left, p.x());
+            right = qMax(right, p.x());
+            top = qMin(top, p.y());
+            bottom = qMax(bottom, p.y());
+        }
+        bounds = QRectF(left, top, right - left, bottom - top).adjusted(-sExtent, -sExtent, sExtent, sExtent);
+    }
+    // A geometry change repaints all of the old bounds, so they only change once a missile leaves them
+    if (!bounds.isEmpty() && !mBounds.contains(bounds))
+    {
+        prepareGeometryChange();
+        mBounds = bounds.adjusted(-sBoundsMargin, -sBoundsMargin, sBoundsMargin, sBoundsMargin);
+    }
+
+    // Only the missiles that moved or turned are repainted, where they were and where they are now
+    auto invalidate = [this, &visible](QPointF pos) {
+        QRectF rect = getMissileRect(pos);
+        if (rect.intersects(visible)) {
+            update(rect);
+        }
+    };
+    const int synced = mSyncedPositions.size();
+    for (int i = 0; i < mPositions.size(); i++)
+    {
+        if (i < synced && mPositions[i] == mSyncedPositions[i] && mBearings[i] == mSyncedBearings[i]) {
+            continue;
+        }
+        if (i < synced) {
+            invalidate(mSyncedPositions[i]);
+        }
+        invalidate(mPositions[i]);
+    }
+    // Removed missiles leave the end of the arrays
+    for (int i = mPositions.size(); i < synced; i++) {
+        invalidate(mSyncedPositions[i]);
+    }
+    mSyncedPositions = mPositions;
+    mSyncedBearings = mBearings;
+}
+
+void MissileBatchItem::getMissileRects(const QRectF& visible, QVector<QRectF>& rects) const
+{
+    rects.clear();
+    QRectF area = visible.adjusted(-sExtent, -sExtent, sExtent, sExtent);
+    for (const auto& p : mPositions)
+    {
+        if (area.contains(p)) {
+            rects << getMissileRect(p);
+        }
+    }
+}
+
+void MissileBatchItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    const auto& lines = getTemplate();
+    QRectF visible = option->exposedRect.adjusted(-sExtent, -sExtent, sExtent, sExtent);
+    mLines.clear();
+    for (int i = 0; i < mPositions.size(); i++)
+    {
+        const QPointF& p = mPositions[i];
+        if (!visible.contains(p)) {
+            continue;
+        }
+        qreal c = qCos(mBearings[i]);
+        qreal s = qSin(mBearings[i]);
+        for (const auto& l : lines)
+        {
+            mLines << QLineF(p.x() + l.x1()*c - l.y1()*s, p.y() + l.x1()*s + l.y1()*c,
+                             p.x() + l.x2()*c - l.y2()*s, p.y() + l.x2()*s + l.y2()*c);
+        }
+    }
+    if (mLines.empty()) {
+        return;
+    }
+
+    QPen pen;
+    pen.setColor(QColor(0, 255, 0));
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(pen);
+    painter->drawLines(mLines);
+}
@@ -5,51 +5,133 @@ void PlayerShipItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
 
     Q_UNUSED(widget);
 
+    if (mSpriteRect.isEmpty()) {
+        return;
+    }
+    qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (mSprite.isNull() || scale != mSpriteScale) {
+        renderSprite(scale);
+    }
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    painter->rotate(mAtan2()*360.0/(M_PI*2.0));
+    painter->drawPixmap(mSpriteRect, mSprite, mSprite.rect());
+    painter->rotate(-mAtan2()*360.0/(M_PI*2.0));
+}
+
+void PlayerShipItem::renderSprite(qreal scale)
+{
+    mSpriteScale = scale;
+    mSprite = QPixmap(qCeil(mSpriteRect.width() * scale), qCeil(mSpriteRect.height() * scale));
+    mSprite.fill(Qt::transparent);
+
+    QPainter painter(&mSprite);
+    painter.scale(scale, scale);
+    painter.translate(-mSpriteRect.topLeft());
+    painter.setRenderHint(QPainter::Antialiasing);
+
     QPen pen;
     QBrush fillBrush;
-
     fillBrush.setStyle(Qt::BrushStyle::SolidPattern);
-    fillBrush.setColor(QColor(0, 255, 0));
-
-    painter->setRenderHint(QPainter::Antialiasing);
-    painter->setPen(pen);
-    painter->rotate(mAtan2()*360.0/(M_PI*2.0));
 
-    for (auto const &e : mEngines)
+    int componentCount = mComponents.size();
+    for (int i = 0; i < mEngines.size(); i++)
     {
-        pen.setColor(QColor(0, int(255.0*e->getNormTemperature()), 0));
-        painter->setPen(pen);
+        const auto& e = mEngines[i];
+        pen.setColor(getBucketColour(mBuckets[e.getComponentIndex()]));
+        painter.setPen(pen);
 
-        fillBrush.setColor(QColor(0, int(255.0*e->getOpacity()), 0));
-        painter->setBrush(fillBrush);
-        painter->drawPolygon(e->getPoly());
+        fillBrush.setColor(getBucketColour(mBuckets[componentCount + i]));
+        painter.setBrush(fillBrush);
+        painter.translate(e.getMarker());
+        painter.drawPolygon(e.getShape());
+        painter.translate(-e.getMarker());
     }
-    painter->setBrush(QColor(0, 0, 0, 0));
-    for (auto const &c : mComponents)
+    for (int i = 0; i < componentCount; i++)
     {
-        pen.setColor(QColor(0, int(255.0*c->getNormTemperature()), 0));
-        painter->setPen(pen);
-        painter->setBrush(QColor(0, 0, 0, 0));
-        painter->drawPolygon(c->getPoly());
-        if (!c->getTexturePoly().isEmpty())
+        const auto& c = mComponents[i];
+        const auto& texture = Component::getTextureShape(c.getType());
+        QColor colour = getBucketColour(mBuckets[i]);
+        painter.translate(c.getScenePos());
+        pen.setColor(colour);
+        painter.setPen(pen);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolygon(Component::getShape(c.getType()));
+        if (!texture.isEmpty())
         {
-            painter->setPen({0, 0, 0, 0});
-            painter->setBrush(QColor(0, int(255.0*c->getNormTemperature()), 0));
-            painter->drawPolygon(c->getTexturePoly());
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(colour);
+            painter.drawPolygon(texture);
         }
+        painter.translate(-c.getScenePos());
     }
-
-    painter->rotate(-mAtan2()*360.0/(M_PI*2.0));
+    painter.end();
 }
 
 QRectF PlayerShipItem::boundingRect() const
 {
-    // Making the bounding rect too big helps with rendering fast moving PlayerShips
-    return {-50, -50, 100, 100};
+    return {-mRadius, -mRadius, mRadius*2.0, mRadius*2.0};
+}
+
+void PlayerShipItem::setShip(Bearing angle, const QVector<Component>& components, const QVector<Engine>& engines, uint32_t revision)
+{
+    bool changed = angle() != mAtan2();
+    mAtan2 = angle;
+    mComponents = components;
+    mEngines = engines;
+    if (revision != mRevision)
+    {
+        mRevision = revision;
+        updateBounds();
+        mSprite = QPixmap();
+        changed = true;
+    }
+
+    // Only rebuild the sprite once a colour would visibly change
+    mNextBuckets.resize(mComponents.size() + mEngines.size());
+    for (int i = 0; i < mComponents.size(); i++) {
+        mNextBuckets[i] = quint8(getBucket(mComponents[i].getNormTemperature()));
+    }
+    for (int i = 0; i < mEngines.size(); i++) {
+        mNextBuckets[mComponents.size() + i] = quint8(getBucket(mEngines[i].getOpacity()));
+    }
+    if (mNextBuckets != mBuckets)
+    {
+        std::swap(mBuckets, mNextBuckets);
+        mSprite = QPixmap();
+        changed = true;
+    }
+
+    if (changed) {
+        update();
+    }
 }
 
-void PlayerShipItem::reset()
+void PlayerShipItem::updateBounds()
 {
-    mEngines.clear();
-    mComponents.clear();
+    qreal radiusSq = 0;
+    QRectF extent;
+    for (auto const &c : mComponents)
+    {
+        QPolygonF poly = c.getPoly();
+        extent |= poly.boundingRect();
+        for (auto const &p : poly) {
+            radiusSq = qMax(radiusSq, QPointF::dotProduct(p, p));
+        }
+    }
+    for (auto const &e : mEngines)
+    {
+        QPolygonF poly = e.getPoly();
+        extent |= poly.boundingRect();
+        for (auto const &p : poly) {
+            radiusSq = qMax(radiusSq, QPointF::dotProduct(p, p));
+        }
+    }
+    // Half the pen plus a pixel for antialiasing
+    mSpriteRect = extent.isNull() ? QRectF() : extent.adjusted(-1.5, -1.5, 1.5, 1.5);
+    qreal radius = qSqrt(radiusSq) + 1.5;
+    if (radius != mRadius) {
+        prepareGeometryChange();
+        mRadius = radius;
+    }
 }
@@ -1,50 +1,131 @@
 #include "include/starfield.h"
 
 
+Starfield::Starfield(QPointF origin, qreal scale, int densityFactor)
+        : mOrigin(origin), mScaleFactor(scale), mDensityFactor(densityFactor)
+{
+    // Only the exposed part of the layer is drawn
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
 void Starfield::updateOffset(QPointF offset)
 {
     offset *= mScaleFactor;
+    if (offset.isNull() && mLastOffset.isNull()) {
+        return;
+    }
     mOrigin += offset;
     mLastOffset = offset;
-    prepareGeometryChange();
+    update();
 }
 
-void Starfield::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+bool Starfield::hasStar(int u, int v)
 {
-    int xOffset = (int)mOrigin.x();
-    int yOffset = (int)mOrigin.y();
-    int sceneInitX = -1000 + (int)(mOrigin.x()) % mDensityFactor;
-    int sceneInitY = -700 + (int)(mOrigin.y()) % mDensityFactor;
-    int sceneX = sceneInitX;
-    int sceneY = sceneInitY;
-    qreal remX = mOrigin.x() - xOffset;
-    qreal remY = mOrigin.y() - yOffset;
+    uint32_t xHash = uint32_t(qAbs(u)) << 16;
+    uint32_t yHash = uint32_t(qAbs(v));
+    if (u < 0) xHash |= 0x80000000;
+    if (v < 0) yHash |= 0x8000;
 
+    // TODO: Improve the procedural generation seeding logic
+    return (lcg_parkmiller(xHash | yHash) & 0x2AAB) == 0x2AAA;
+}
+
+const Starfield::Tile& Starfield::getTile(int tx, int ty)
+{
+    quint64 key = tileKey(tx, ty);
+    auto it = mTiles.find(key);
+    if (it != mTiles.end()) {
+        return it.value();
+    }
+
+    Tile tile;
+    int pixels = qCeil(sTileSize * mTileScale);
+    tile.pixmap = QPixmap(pixels, pixels);
+    tile.pixmap.fill(Qt::transparent);
+
+    QPainter painter(&tile.pixmap);
     QPen pen;
     pen.setColor(QColor(0, 100, 0));
-    painter->setPen(pen);
-    painter->setRenderHint(QPainter::Antialiasing);
+    painter.setPen(pen);
+    painter.setRenderHint(QPainter::Antialiasing);
 
-    // TODO: Improve the procedural generation seeding logic
-    for (int x = xOffset; x < xOffset + 2000; x += mDensityFactor)
+    // The lattice is offset so that it lines up with the top-left corner of the original view
+    int x0 = tx * sTileSize;
+    int y0 = ty * sTileSize;
+    int uStart = x0 + (((-1000 - x0) % mDensityFactor) + mDensityFactor) % mDensityFactor;
+    int vStart = y0 + (((-700 - y0) % mDensityFactor) + mDensityFactor) % mDensityFactor;
+    for (int u = uStart; u < x0 + sTileSize; u += mDensityFactor)
     {
-        for (int y = yOffset; y < yOffset + 1400; y += mDensityFactor)
+        for (int v = vStart; v < y0 + sTileSize; v += mDensityFactor)
         {
-            uint32_t xHash = uint32_t(qAbs(sceneX - xOffset)) << 16;
-            uint32_t yHash = uint32_t(qAbs(sceneY - yOffset));
-            if (sceneX - xOffset < 0) xHash |= 0x80000000;
-            if (sceneY - yOffset < 0) yHash |= 0x8000;
-
-            uint32_t prng = lcg_parkmiller(xHash | yHash) & 0x2AAB;
-            if (prng == 0x2AAA)
+            if (hasStar(u, v))
             {
-                painter->drawLine(QLineF(sceneX+remX, sceneY+remY,
-                                         sceneX+remX+mLastOffset.x(), sceneY+remY+mLastOffset.y()));
+                tile.stars << QPointF(u, v);
+                painter.drawPoint(QPointF((u - x0) * mTileScale, (v - y0) * mTileScale));
+            }
+        }
+    }
+    painter.end();
+
+    return mTiles.insert(key, tile).value();
+}
+
+void Starfield::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    // Tiles are rendered at device resolution, so re-render them if the view is zoomed
+    qreal scale = painter->worldTransform().m11();
+    if (scale != mTileScale) {
+        mTiles.clear();
+        mTileScale = scale;
+    }
+
+    QRectF exposed = option->exposedRect.intersected(boundingRect()).translated(-mOrigin);
+    int txStart = qFloor(exposed.left() / sTileSize);
+    int txEnd = qFloor(exposed.right() / sTileSize);
+    int tyStart = qFloor(exposed.top() / sTileSize);
+    int tyEnd = qFloor(exposed.bottom() / sTileSize);
+
+    bool streaking = qAbs(mLastOffset.x()) + qAbs(mLastOffset.y()) > 0.5;
+    mStreaks.clear();
+    for (int tx = txStart; tx <= txEnd; tx++)
+    {
+        for (int ty = tyStart; ty <= tyEnd; ty++)
+        {
+            const auto& tile = getTile(tx, ty);
+            QRectF target(tx * sTileSize + mOrigin.x(), ty * sTileSize + mOrigin.y(), sTileSize, sTileSize);
+            painter->drawPixmap(target, tile.pixmap, tile.pixmap.rect());
+            if (streaking) {
+                for (const auto& star : tile.stars) {
+                    mStreaks << QLineF(star + mOrigin, star + mOrigin + mLastOffset);
+                }
+            }
+        }
+    }
+
+    if (!mStreaks.empty())
+    {
+        QPen pen;
+        pen.setColor(QColor(0, 100, 0));
+        painter->setPen(pen);
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->drawLines(mStreaks);
+    }
+
+    // Forget the tiles that have scrolled out of view once the cache grows too large
+    if (mTiles.size() > sMaxTiles)
+    {
+        for (auto it = mTiles.begin(); it != mTiles.end();)
+        {
+            int tx = int(it.key() >> 32);
+            int ty = int(quint32(it.key()));
+            if (tx < txStart || tx > txEnd || ty < tyStart || ty > tyEnd) {
+                it = mTiles.erase(it);
+            } else {
+                it++;
             }
-            sceneY += mDensityFactor;
         }
-        sceneY = sceneInitY;
-        sceneX += mDensityFactor;
     }
 }
 
@@ -60,4 +141,4 @@ uint32_t Starfield::lcg_parkmiller(uint32_t state)
 QRectF Starfield::boundingRect() const
 {
     return {-1000, -700, 2000, 1400};
-}
\ No newline at end of file
+}
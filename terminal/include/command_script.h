@@ -0,0 +1,39 @@
+#include "include/directions.h"
+
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * A command for the player ship, compiled from terminal input and
+ * applied by the simulation thread at the start of a tick.
+ */
+struct ShipCommand
+{
+    enum class Type
+    {
+        Thrust,
+        Rotate,
+    };
+
+    Type type {Type::Thrust};
+    TwoDeg direction {TwoDeg::Up};
+    bool isActive {false};
+    int degrees {0};
+};
+
+/**
+ * A ship command to apply on the given tick, counted from the tick the script started on.
+ */
+struct ScriptEvent
+{
+    uint32_t tick {0};
+    ShipCommand command;
+};
+
+Q_DECLARE_TYPEINFO(ShipCommand, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(ScriptEvent, Q_PRIMITIVE_TYPE);
+
+// Events sorted by tick, commands on the same tick keep their order in the script
+using CommandScript = QVector<ScriptEvent>;
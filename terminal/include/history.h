@@ -1,16 +1,32 @@
+#include "include/log_model.h"
+
 #include <QtWidgets>
-#include <QPlainTextEdit>
 
 #pragma once
 
 
-class History : public QPlainTextEdit
+/**
+ * Scrolling view of the terminal log. Lines have a fixed height, so only
+ * the lines inside the viewport are laid out and drawn, however many the
+ * log holds. Stays pinned to the newest line unless scrolled back.
+ */
+class History : public QAbstractScrollArea
 {
 Q_OBJECT
 public:
-    History();
+    explicit History(LogModel* log);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private Q_SLOTS:
+    void handleLineAppended(int evicted);
+    void handleLineChanged(int index);
 
-public Q_SLOTS:
-    void addCommand(const QString &text);
+private:
+    void updateScrollRange();
 
-};
\ No newline at end of file
+    LogModel* mLog;
+    int mLineHeight;
+};
@@ -0,0 +1,83 @@
+#include <QtWidgets>
+
+#pragma once
+
+
+/**
+ * Fixed-capacity history of terminal messages.
+ *
+ * Lines are held in a ring, so once full the oldest line is overwritten and
+ * memory stays bounded however long the session runs. A message repeating the
+ * previous line is folded into that line's count rather than appended. Each
+ * distinct message is also rate limited on its own, so a source repeating the
+ * same status between other messages is folded into its latest line as well.
+ */
+class LogModel : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Level
+    {
+        Log,
+        Info,
+        Warning,
+        Error
+    };
+
+    struct Line
+    {
+        Level level {Level::Log};
+        QString text;
+        int count {0}; // Number of times the message was received
+    };
+
+    explicit LogModel(int capacity = 1000, QObject* parent = nullptr);
+
+    /**
+     * Adds a message to the log.
+     * @param level - Severity, prefixed to the text when displayed.
+     * @param text - The message, also used as the rate limiting key.
+     */
+    void append(Level level, const QString& text);
+
+    /**
+     * @param i - Index of the line, 0 is the oldest held line.
+     */
+    const Line& at(int i) const { return mLines[(mStart + i) % mLines.size()]; }
+    int size() const { return mSize; }
+    int getCapacity() const { return mLines.size(); }
+
+    static QString getPrefix(Level level);
+
+Q_SIGNALS:
+    /**
+     * @param evicted - Number of the oldest lines overwritten to make room, so indices shift down by it.
+     */
+    void lineAppended(int evicted);
+    void lineChanged(int index);
+
+private:
+    struct Limiter
+    {
+        qreal tokens {0};
+        qint64 lastRefill {0};
+        uint64_t lastSequence {0};
+    };
+
+    constexpr static qreal sBurst {4}; // Lines a message may append back to back
+    constexpr static qreal sRate {1}; // Lines per second once the burst is used
+
+    /**
+     * Returns the index of the line with the given sequence number, or -1 if it has been overwritten.
+     */
+    int indexOf(uint64_t sequence) const;
+    void bump(int index);
+
+    QVector<Line> mLines;
+    int mStart {0};
+    int mSize {0};
+    uint64_t mNextSequence {0};
+
+    QHash<QString, Limiter> mLimiters;
+    QElapsedTimer mClock;
+};
@@ -1,9 +1,13 @@
+#include "include/command_script.h"
 #include "include/input.h"
 #include "include/history.h"
+#include "include/log_model.h"
 #include "include/directions.h"
 
 #include <QtWidgets>
 
+#include <memory>
+
 #pragma once
 
 
@@ -19,7 +23,14 @@ Q_SIGNALS:
     void setThrustDirection(TwoDeg direction, bool isActive);
     void rotate(int degrees);
     void toggleMapZoom();
+    void setMapZoom(qreal zoom);
     void toggleTacticalZoom();
+    void startCapture(bool png);
+    void stopCapture();
+    void runScript(std::shared_ptr<const CommandScript> script);
+    void stopScript();
+    void startTelemetry(const QString& target, bool isSocket);
+    void stopTelemetry();
 
 public Q_SLOTS:
     void parseInput(const QString& rawText);
@@ -35,21 +46,48 @@ private:
         Thrust,
         Rotate,
         Alias,
-        Zoom
+        Zoom,
+        Capture,
+        Run,
+        Telemetry
     };
 
     void parseCommand(const QString& command, const QString& input);
-    void parseThrustCommand(const QString& direction, bool isActive);
+    void parseShipCommand(const QString& command, const QString& input);
     void parseAliasCommand(const QString& input);
-    void parseRotateCommand(const QString& input);
     void parseZoomCommand(const QString& input);
+    void parseCaptureCommand(const QString& input);
+    void parseRunCommand(const QString& input);
+    void parseTelemetryCommand(const QString& input);
+
+    QString resolveAlias(const QString& word) const { return mAliases.value(word, word); }
+
+    /**
+     * Compiles a thrust or rotate command, shared by the terminal input and scripts.
+     * @param command - The (alias resolved) command word.
+     * @param input - The arguments following the command.
+     * @param shipCommand - Filled in if the command is valid.
+     * @return The error to display, empty if the command is valid.
+     */
+    QString compileShipCommand(const QString& command, const QString& input, ShipCommand& shipCommand) const;
+    QString compileThrustCommand(const QString& input, bool isActive, ShipCommand& shipCommand) const;
+    QString compileRotateCommand(const QString& input, ShipCommand& shipCommand) const;
+
+    /**
+     * Compiles one line of a script into an event appended to the script.
+     * @return The error to display, empty if the line is valid.
+     */
+    QString compileScriptLine(const QString& line, CommandScript& script) const;
+
+    constexpr static int sLogCapacity {1000};
 
+    LogModel* mLog;
     History* mHistory;
     Input* mInput;
 
-    QMap<QString, QString> mAliases;
+    QHash<QString, QString> mAliases;
 
     // Command lookups
-    QMap<QString, TwoDeg> mLookupDirection;
-    QMap<QString, Command> mLookupCommands;
+    QHash<QString, TwoDeg> mLookupDirection;
+    QHash<QString, Command> mLookupCommands;
 };
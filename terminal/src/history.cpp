@@ -1,15 +1,77 @@
 #include "include/history.h"
 
 
-History::History() : QPlainTextEdit()
+History::History(LogModel* log) : QAbstractScrollArea(), mLog(log)
 {
-    setReadOnly(true);
     setStyleSheet("border: 0px; color: #00ff00; background-color: black; font-size: 15px; font-family: \"OCR A Extended\"");
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    ensurePolished();
+    mLineHeight = fontMetrics().lineSpacing();
+
+    connect(mLog, &LogModel::lineAppended, this, &History::handleLineAppended);
+    connect(mLog, &LogModel::lineChanged, this, &History::handleLineChanged);
+}
+
+void History::updateScrollRange()
+{
+    int visible = qMax(1, viewport()->height() / mLineHeight);
+    verticalScrollBar()->setPageStep(visible);
+    verticalScrollBar()->setRange(0, qMax(0, mLog->size() - visible));
+}
+
+void History::handleLineAppended(int evicted)
+{
+    auto scrollBar = verticalScrollBar();
+    bool isPinned = scrollBar->value() == scrollBar->maximum();
+    updateScrollRange();
+    if (isPinned) {
+        scrollBar->setValue(scrollBar->maximum());
+    } else if (evicted > 0) {
+        // Keep the same lines in view while scrolled back, as every index moved down
+        scrollBar->setValue(scrollBar->value() - evicted);
+    }
+    viewport()->update();
+}
+
+void History::handleLineChanged(int index)
+{
+    int row = index - verticalScrollBar()->value();
+    if (row >= 0 && row <= verticalScrollBar()->pageStep()) {
+        viewport()->update(0, row*mLineHeight, viewport()->width(), mLineHeight);
+    }
+}
+
+void History::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    handleLineAppended(0);
 }
 
-void History::addCommand(const QString &text)
+void History::paintEvent(QPaintEvent* event)
 {
-    appendPlainText(text);
-}
\ No newline at end of file
+    QPainter painter(viewport());
+    painter.setFont(font());
+    painter.setPen(palette().color(QPalette::WindowText));
+
+    auto metrics = fontMetrics();
+    int width = viewport()->width();
+    int first = verticalScrollBar()->value() + event->rect().top() / mLineHeight;
+    int last = qMin(mLog->size() - 1, verticalScrollBar()->value() + event->rect().bottom() / mLineHeight);
+    for (int i = first; i <= last; i++)
+    {
+        const auto& line = mLog->at(i);
+        QRect rect(0, (i - verticalScrollBar()->value()) * mLineHeight, width, mLineHeight);
+
+        // The repeat count follows the message, only the message is elided
+        QString count = line.count > 1 ? QString(" %1%2").arg(QChar(0x00D7)).arg(line.count) : QString();
+        int countWidth = metrics.horizontalAdvance(count);
+        QString text = metrics.elidedText(LogModel::getPrefix(line.level) + line.text, Qt::ElideRight, width - countWidth);
+        painter.drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, text);
+        if (!count.isEmpty())
+        {
+            rect.setLeft(metrics.horizontalAdvance(text));
+            painter.drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, count);
+        }
+    }
+}
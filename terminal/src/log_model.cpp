@@ -0,0 +1,103 @@
+#include "include/log_model.h"
+
+
+LogModel::LogModel(int capacity, QObject* parent) : QObject(parent)
+{
+    mLines.resize(qMax(capacity, 1));
+    mClock.start();
+}
+
+QString LogModel::getPrefix(Level level)
+{
+    switch (level)
+    {
+        case Level::Log:
+            return "<LOG> - ";
+        case Level::Info:
+            return "<INFO> - ";
+        case Level::Warning:
+            return "<WARNING> - ";
+        case Level::Error:
+            return "<ERROR> - ";
+    }
+    return "";
+}
+
+void LogModel::append(Level level, const QString& text)
+{
+    // Repeats of the newest line only ever bump its count
+    if (mSize > 0)
+    {
+        const Line& last = at(mSize - 1);
+        if (last.level == level && last.text == text) {
+            bump(mSize - 1);
+            return;
+        }
+    }
+
+    // The echoed user input is never limited, only messages from the simulation
+    if (level != Level::Log)
+    {
+        qint64 now = mClock.elapsed();
+        auto limiter = mLimiters.find(text);
+        if (limiter == mLimiters.end()) {
+            limiter = mLimiters.insert(text, {sBurst, now, 0});
+        }
+        limiter->tokens = qMin(sBurst, limiter->tokens + (now - limiter->lastRefill) * 1e-3 * sRate);
+        limiter->lastRefill = now;
+        if (limiter->tokens < 1)
+        {
+            int index = indexOf(limiter->lastSequence);
+            if (index >= 0 && at(index).level == level) {
+                bump(index);
+                return;
+            }
+        }
+        else
+            limiter->tokens -= 1;
+        limiter->lastSequence = mNextSequence;
+    }
+
+    int capacity = mLines.size();
+    Line& line = mLines[(mStart + mSize) % capacity];
+    line.level = level;
+    line.text = text;
+    line.count = 1;
+    int evicted = 0;
+    if (mSize < capacity) {
+        mSize++;
+    } else {
+        mStart = (mStart + 1) % capacity;
+        evicted = 1;
+    }
+    mNextSequence++;
+
+    // Forget limiters whose lines are long gone, so distinct messages cannot grow the table forever
+    if (mLimiters.size() > 2*capacity)
+    {
+        for (auto it = mLimiters.begin(); it != mLimiters.end();)
+        {
+            if (indexOf(it->lastSequence) < 0) {
+                it = mLimiters.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+    Q_EMIT lineAppended(evicted);
+}
+
+int LogModel::indexOf(uint64_t sequence) const
+{
+    uint64_t first = mNextSequence - uint64_t(mSize);
+    if (sequence < first || sequence >= mNextSequence) {
+        return -1;
+    }
+    return int(sequence - first);
+}
+
+void LogModel::bump(int index)
+{
+    mLines[(mStart + index) % mLines.size()].count++;
+    Q_EMIT lineChanged(index);
+}
@@ -1,11 +1,12 @@
 #include "include/terminal.h"
 
-#include <QRegExp>
+#include <algorithm>
 
 
 Terminal::Terminal(QWidget* parent) : QFrame(parent)
 {
-    mHistory = new History();
+    mLog = new LogModel(sLogCapacity, this);
+    mHistory = new History(mLog);
     mInput = new Input();
 
     mLookupDirection["FORWARD"] = TwoDeg::Up;
@@ -19,6 +20,9 @@ Terminal::Terminal(QWidget* parent) : QFrame(parent)
     mLookupCommands["ROTATE"] = Command::Rotate;
 
     mLookupCommands["ZOOM"] = Command::Zoom;
+    mLookupCommands["CAPTURE"] = Command::Capture;
+    mLookupCommands["RUN"] = Command::Run;
+    mLookupCommands["TELEMETRY"] = Command::Telemetry;
 
     connect(mInput, &Input::sendRawInput, this, &Terminal::parseInput);
 
@@ -33,57 +37,105 @@ Terminal::Terminal(QWidget* parent) : QFrame(parent)
 
 void Terminal::parseInput(const QString& rawText)
 {
-    QRegularExpression re("(\\w+) (.+)");
-    QRegularExpressionMatch match = re.match(rawText);
     Q_EMIT displayLog(rawText);
 
-    if (match.hasMatch())
+    // <COMMAND> <ARGUMENTS>, the arguments are parsed by each command
+    int split = rawText.indexOf(' ');
+    if (split < 1 || split == rawText.size() - 1)
     {
-        QString aliasedCommand = match.captured(1);
-        if (mAliases.contains(aliasedCommand)) aliasedCommand = mAliases[aliasedCommand];
-        parseCommand(aliasedCommand, match.captured(2));
-    }
-    else
         Q_EMIT displayError(QString("INVALID ENTRY"));
+        return;
+    }
+    parseCommand(resolveAlias(rawText.left(split)), rawText.mid(split + 1));
 }
 
 void Terminal::parseCommand(const QString& command, const QString& input)
 {
-    switch (mLookupCommands[command])
+    switch (mLookupCommands.value(command, Command::None))
     {
         case Command::Thrust:
-            parseThrustCommand(input, command == "START");
+        case Command::Rotate:
+            parseShipCommand(command, input);
             break;
         case Command::Alias:
             parseAliasCommand(input);
             break;
-        case Command::Rotate:
-            parseRotateCommand(input);
-            break;
         case Command::Zoom:
             parseZoomCommand(input);
             break;
+        case Command::Capture:
+            parseCaptureCommand(input);
+            break;
+        case Command::Run:
+            parseRunCommand(input);
+            break;
+        case Command::Telemetry:
+            parseTelemetryCommand(input);
+            break;
         case Command::None:
             displayError(QString("INVALID COMMAND: %1").arg(command));
             return;
     }
 }
 
-void Terminal::parseThrustCommand(const QString& input, bool isActive)
+void Terminal::parseShipCommand(const QString& command, const QString& input)
 {
-    QStringList args = input.split(" ");
-    if (args.size() > 1)
+    ShipCommand shipCommand;
+    QString error = compileShipCommand(command, input, shipCommand);
+    if (!error.isEmpty())
     {
-        Q_EMIT displayError(QString("COMMAND: %1 ACCEPTS ONE ARGUMENT").arg(isActive ? "START" : "STOP"));
+        Q_EMIT displayError(error);
         return;
     }
-    QString direction = args[0];
-    if (mAliases.contains(direction)) direction = mAliases[direction];
+    switch (shipCommand.type)
+    {
+        case ShipCommand::Type::Thrust:
+            Q_EMIT setThrustDirection(shipCommand.direction, shipCommand.isActive);
+            break;
+        case ShipCommand::Type::Rotate:
+            Q_EMIT rotate(shipCommand.degrees);
+            break;
+    }
+}
 
-    if (mLookupDirection.contains(direction))
-        setThrustDirection(mLookupDirection[direction], isActive);
-    else
-        Q_EMIT displayError(QString("INVALID DIRECTION: %1").arg(direction));
+QString Terminal::compileShipCommand(const QString& command, const QString& input, ShipCommand& shipCommand) const
+{
+    switch (mLookupCommands.value(command, Command::None))
+    {
+        case Command::Thrust:
+            return compileThrustCommand(input, command == "START", shipCommand);
+        case Command::Rotate:
+            return compileRotateCommand(input, shipCommand);
+        default:
+            return QString("NOT A SHIP COMMAND: %1").arg(command);
+    }
+}
+
+QString Terminal::compileThrustCommand(const QString& input, bool isActive, ShipCommand& shipCommand) const
+{
+    QStringList args = input.split(" ");
+    if (args.size() > 1) {
+        return QString("COMMAND: %1 ACCEPTS ONE ARGUMENT").arg(isActive ? "START" : "STOP");
+    }
+    QString direction = resolveAlias(args[0]);
+    if (!mLookupDirection.contains(direction)) {
+        return QString("INVALID DIRECTION: %1").arg(direction);
+    }
+    shipCommand.type = ShipCommand::Type::Thrust;
+    shipCommand.direction = mLookupDirection[direction];
+    shipCommand.isActive = isActive;
+    return QString();
+}
+
+QString Terminal::compileRotateCommand(const QString& input, ShipCommand& shipCommand) const
+{
+    int degrees = input.toInt();
+    if (degrees == 0) {
+        return QString("COMMAND: ROTATE ACCEPTS ONE NON-ZERO INTEGER");
+    }
+    shipCommand.type = ShipCommand::Type::Rotate;
+    shipCommand.degrees = degrees;
+    return QString();
 }
 
 void Terminal::parseAliasCommand(const QString& input)
@@ -98,20 +150,20 @@ void Terminal::parseAliasCommand(const QString& input)
     Q_EMIT displayInfo(QString("ALIAS %1 == %2").arg(inputs[1]).arg(inputs[0]));
 }
 
-void Terminal::parseRotateCommand(const QString &input)
+void Terminal::parseZoomCommand(const QString &input)
 {
-    int degrees = input.toInt();
-    if (degrees == 0)
+    QStringList args = input.split(" ");
+    if (args.size() == 2 && args[0] == "MAP")
     {
-        Q_EMIT displayError(QString("COMMAND: ROTATE ACCEPTS ONE NON-ZERO INTEGER"));
+        bool isValid = false;
+        qreal zoom = args[1].toDouble(&isValid);
+        if (!isValid || zoom <= 0) {
+            Q_EMIT displayError(QString("COMMAND: ZOOM MAP ACCEPTS ONE POSITIVE SCALE"));
+            return;
+        }
+        Q_EMIT setMapZoom(zoom);
         return;
     }
-    rotate(degrees);
-}
-
-void Terminal::parseZoomCommand(const QString &input)
-{
-    QStringList args = input.split(" ");
     if (args.size() > 1)
     {
         Q_EMIT displayError(QString("COMMAND: ZOOM ACCEPTS ONE ARGUMENT"));
@@ -126,22 +178,119 @@ void Terminal::parseZoomCommand(const QString &input)
     }
 }
 
+void Terminal::parseCaptureCommand(const QString &input)
+{
+    if (input == "PNG") {
+        Q_EMIT startCapture(true);
+    } else if (input == "RAW") {
+        Q_EMIT startCapture(false);
+    } else if (input == "STOP") {
+        Q_EMIT stopCapture();
+    } else {
+        Q_EMIT displayError(QString("INVALID CAPTURE COMMAND: OPTIONS ARE PNG/RAW/STOP"));
+    }
+}
+
+void Terminal::parseRunCommand(const QString& input)
+{
+    if (input == "STOP")
+    {
+        Q_EMIT stopScript();
+        return;
+    }
+    QFile file(input);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        Q_EMIT displayError(QString("CANNOT OPEN SCRIPT: %1").arg(input));
+        return;
+    }
+
+    // The whole script is compiled up front, nothing is parsed once it is running
+    auto script = std::make_shared<CommandScript>();
+    QTextStream stream(&file);
+    for (int lineNumber = 1; !stream.atEnd(); lineNumber++)
+    {
+        QString line = stream.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        QString error = compileScriptLine(line, *script);
+        if (!error.isEmpty())
+        {
+            Q_EMIT displayError(QString("SCRIPT LINE %1: %2").arg(lineNumber).arg(error));
+            return;
+        }
+    }
+    std::stable_sort(script->begin(), script->end(),
+                     [](const ScriptEvent& a, const ScriptEvent& b) { return a.tick < b.tick; });
+
+    uint32_t duration = script->empty() ? 0 : script->last().tick;
+    Q_EMIT displayInfo(QString("RUNNING SCRIPT: %1 COMMANDS OVER %2 TICKS").arg(script->size()).arg(duration));
+    Q_EMIT runScript(script);
+}
+
+QString Terminal::compileScriptLine(const QString& line, CommandScript& script) const
+{
+    // AT <TICK> <COMMAND> <ARGUMENTS>
+    QStringList words = line.split(' ', Qt::SkipEmptyParts);
+    if (words.size() < 4 || words[0] != "AT") {
+        return QString("EXPECTED: AT <TICK> <COMMAND> <ARGUMENTS>");
+    }
+    bool isValid = false;
+    uint tick = words[1].toUInt(&isValid);
+    if (!isValid) {
+        return QString("INVALID TICK: %1").arg(words[1]);
+    }
+    QString command = resolveAlias(words[2]);
+    Command type = mLookupCommands.value(command, Command::None);
+    if (type != Command::Thrust && type != Command::Rotate) {
+        return QString("COMMAND CANNOT BE SCRIPTED: %1").arg(command);
+    }
+
+    ScriptEvent event;
+    event.tick = tick;
+    QString error = compileShipCommand(command, words.mid(3).join(' '), event.command);
+    if (error.isEmpty()) {
+        script.append(event);
+    }
+    return error;
+}
+
+void Terminal::parseTelemetryCommand(const QString& input)
+{
+    if (input == "STOP")
+    {
+        Q_EMIT stopTelemetry();
+        return;
+    }
+    // The target may contain spaces, so only the first word is split off
+    int split = input.indexOf(' ');
+    QString type = input.left(split);
+    QString target = split < 0 ? QString() : input.mid(split + 1).trimmed();
+    if ((type != "FILE" && type != "SOCKET") || target.isEmpty())
+    {
+        Q_EMIT displayError(QString("INVALID TELEMETRY COMMAND: OPTIONS ARE FILE <PATH>/SOCKET <NAME>/STOP"));
+        return;
+    }
+    Q_EMIT startTelemetry(target, type == "SOCKET");
+}
+
 void Terminal::displayLog(const QString &text)
 {
-    mHistory->addCommand("<LOG> - " + text);
+    mLog->append(LogModel::Level::Log, text);
 }
 
 void Terminal::displayInfo(const QString &text)
 {
-    mHistory->addCommand("<INFO> - " + text);
+    mLog->append(LogModel::Level::Info, text);
 }
 
 void Terminal::displayWarning(const QString &text)
 {
-    mHistory->addCommand("<WARNING> - " + text);
+    mLog->append(LogModel::Level::Warning, text);
 }
 
 void Terminal::displayError(const QString &text)
 {
-    mHistory->addCommand("<ERROR> - " + text);
+    mLog->append(LogModel::Level::Error, text);
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "include/telemetry_format.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTextStream>
+
+#include <memory>
+
+
+/**
+ * Decodes a telemetry stream written by the game (see telemetry_format.h) to text.
+ *
+ * Reads a recorded file, or listens on a local socket for the game to connect
+ * to with TELEMETRY SOCKET <name>. Each tick is printed as one line, followed
+ * by one line per record unless only a summary is asked for.
+ */
+
+namespace
+{
+
+/**
+ * Reads exactly the given number of bytes, waiting for more if the device is a socket.
+ * @return False at the end of the stream.
+ */
+bool readExact(QIODevice* device, char* data, qint64 size)
+{
+    while (size > 0)
+    {
+        qint64 read = device->read(data, size);
+        if (read < 0) {
+            return false;
+        }
+        if (read == 0 && !device->waitForReadyRead(-1)) {
+            return false;
+        }
+        data += read;
+        size -= read;
+    }
+    return true;
+}
+
+template <typename T>
+bool readRecord(QIODevice* device, T& record)
+{
+    return readExact(device, reinterpret_cast<char*>(&record), sizeof(T));
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decodes a blockade runner telemetry stream");
+    parser.addHelpOption();
+    QCommandLineOption listenOption("listen", "Listen on a local socket instead of reading a file.", "name");
+    QCommandLineOption summaryOption("summary", "Only print one line per tick.");
+    parser.addOptions({listenOption, summaryOption});
+    parser.addPositionalArgument("file", "Recorded telemetry file, unless listening.");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    std::unique_ptr<QIODevice> device;
+    QLocalServer server;
+    if (parser.isSet(listenOption))
+    {
+        QLocalServer::removeServer(parser.value(listenOption));
+        if (!server.listen(parser.value(listenOption)))
+        {
+            err << "Cannot listen on " << parser.value(listenOption) << ": " << server.errorString() << "\n";
+            return 1;
+        }
+        err << "Waiting for the game on " << server.fullServerName() << "\n";
+        err.flush();
+        if (!server.waitForNewConnection(-1))
+        {
+            err << "No connection on " << server.fullServerName() << ": " << server.errorString() << "\n";
+            return 1;
+        }
+        device.reset(server.nextPendingConnection());
+        device->setParent(nullptr);
+    }
+    else
+    {
+        if (parser.positionalArguments().size() != 1) {
+            parser.showHelp(1);
+        }
+        auto file = std::make_unique<QFile>(parser.positionalArguments()[0]);
+        if (!file->open(QIODevice::ReadOnly))
+        {
+            err << "Cannot open " << file->fileName() << ": " << file->errorString() << "\n";
+            return 1;
+        }
+        device = std::move(file);
+    }
+
+    Telemetry::StreamHeader header;
+    if (!readRecord(device.get(), header) || memcmp(header.magic, Telemetry::sMagic, sizeof(header.magic)) != 0)
+    {
+        err << "Not a telemetry stream\n";
+        return 1;
+    }
+    if (quint16(header.version) != Telemetry::sVersion)
+    {
+        err << "Unsupported telemetry version " << quint16(header.version) << "\n";
+        return 1;
+    }
+
+    // Decoded with the scales from the stream, so older recordings stay readable if the defaults change
+    const float positionScale = header.positionScale;
+    const float velocityScale = header.velocityScale;
+    const float angleScale = header.angleScale;
+    const float ratioScale = header.ratioScale;
+    const float temperatureScale = header.temperatureScale;
+    auto position = [positionScale](int32_t v) { return v / positionScale; };
+    auto velocity = [velocityScale](int16_t v) { return v / velocityScale; };
+    auto angle = [angleScale](uint16_t v) { return v / angleScale; };
+    bool isSummary = parser.isSet(summaryOption);
+
+    int ticks = 0;
+    Telemetry::TickHeader tick;
+    while (readRecord(device.get(), tick))
+    {
+        // Converted from little-endian once
+        const int objects = tick.objects;
+        const int tracks = tick.tracks;
+        const int engines = tick.engines;
+        const int components = tick.components;
+        out << "tick " << quint32(tick.tick) << " objects=" << objects << " tracks=" << tracks
+            << " engines=" << engines << " components=" << components << "\n";
+        ticks++;
+        if (isSummary)
+        {
+            QByteArray skipped(int(tick.size), Qt::Uninitialized);
+            if (!readExact(device.get(), skipped.data(), skipped.size())) {
+                break;
+            }
+            continue;
+        }
+
+        bool isComplete = true;
+        for (int i = 0; i < objects && isComplete; i++)
+        {
+            Telemetry::ObjectRecord record;
+            isComplete = readRecord(device.get(), record);
+            if (!isComplete) {
+                break;
+            }
+            out << "  object uid=" << quint32(record.uid) << " faction=" << int(record.faction)
+                << " x=" << position(record.x) << " y=" << position(record.y)
+                << " vx=" << velocity(record.vx) << " vy=" << velocity(record.vy)
+                << " heading=" << angle(record.heading) << "\n";
+        }
+        for (int i = 0; i < tracks && isComplete; i++)
+        {
+            Telemetry::TrackRecord record;
+            isComplete = readRecord(device.get(), record);
+            if (!isComplete) {
+                break;
+            }
+            out << "  track uid=" << quint32(record.uid) << " faction=" << int(record.faction)
+                << " current=" << int(record.isCurrent)
+                << " x=" << position(record.x) << " y=" << position(record.y)
+                << " vx=" << velocity(record.vx) << " vy=" << velocity(record.vy) << "\n";
+        }
+        for (int i = 0; i < engines && isComplete; i++)
+        {
+            Telemetry::EngineRecord record;
+            isComplete = readRecord(device.get(), record);
+            if (!isComplete) {
+                break;
+            }
+            out << "  engine component=" << quint16(record.component)
+                << " thrust=" << quint16(record.thrustRatio) / ratioScale << "\n";
+        }
+        for (int i = 0; i < components && isComplete; i++)
+        {
+            Telemetry::ComponentRecord record;
+            isComplete = readRecord(device.get(), record);
+            if (!isComplete) {
+                break;
+            }
+            out << "  component x=" << int(record.x) << " y=" << int(record.y) << " type=" << int(record.type)
+                << " temperature=" << quint16(record.temperature) / temperatureScale << "\n";
+        }
+        if (!isComplete) {
+            break;
+        }
+    }
+    out.flush();
+    err << ticks << " ticks decoded\n";
+    return 0;
+}
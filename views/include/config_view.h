@@ -59,8 +59,8 @@ public:
 public Q_SLOTS:
     void handleClose();
     void updateStats(QString mass, QString linearAcc, QString leftAcc, QString rightAcc, QString hasSensors);
-    void drawConfigComponent(std::shared_ptr<Component> component);
-    void drawConfigEngine(std::shared_ptr<Engine> engine);
+    void drawConfigComponent(const Component& component);
+    void drawConfigEngine(const Engine& engine, const Component& component);
     void drawCentreOfMass(qreal x, qreal y);
     void drawCentreOfRotation(qreal x, qreal y);
     void deleteAllComponents();
@@ -4,6 +4,7 @@
 #include "include/acceleration_marker.h"
 #include "include/signal_track_processor.h"
 #include "include/strategic_symbol.h"
+#include "include/track_cluster_item.h"
 
 #include <QFrame>
 #include <QGraphicsView>
@@ -18,10 +19,27 @@ class StrategicView : public QGraphicsView
 public:
     explicit StrategicView(QGraphicsScene* scene);
 
+    /**
+     * Toggles between the default scale and zoomed out by half.
+     */
     void toggleZoom();
 
+    /**
+     * Sets the scale of the map, clamped to the supported range.
+     * @param zoom - Pixels per scene unit.
+     */
+    void setZoom(qreal zoom);
+    qreal getZoom() const { return mZoom; }
+
+protected:
+    void wheelEvent(QWheelEvent* event) override;
+
 private:
-    bool mZoomed = true;
+    constexpr static qreal sMinZoom {0.05};
+    constexpr static qreal sMaxZoom {4};
+    constexpr static qreal sWheelStep {1.2}; // Zoom factor per wheel notch
+
+    qreal mZoom = 1;
 };
 
 class StrategicScene : public QGraphicsScene
@@ -32,22 +50,38 @@ public:
 
     void initBackground();
 
-    void visualiseTracks(const QVector<SignalTrackProcessor::ProcessedTrack>& tracks);
-    void updateTrack(SignalTrackProcessor::ProcessedTrack track);
+    void visualiseTracks(TrackView tracks);
+    void updateTrack(const ProcessedTrack& track);
 
     void applyPlayerUpdate(QPointF posOffset, Bearing angle, Vector vel, Vector acc);
     StrategicView* getView() const;
 
 public Q_SLOTS:
     void toggleZoom();
+    void setZoom(qreal zoom);
 
 private:
+    /**
+     * Bins the track symbols into a screen-space grid. Any cell holding more than one
+     * track is drawn as a single cluster, so the paint cost is bounded by the area of
+     * the screen rather than the number of tracks.
+     */
+    void clusterTracks();
+
+    constexpr static qreal sClusterPixels {32}; // Edge length of a cluster cell on screen
+
     StrategicView* mView;
     PlayerSymbolItem* mPlayerSymbol;
     GridLines* mGridLines;
     QVector<AccelerationMarker*> mAccMarkers;
     QVector<VelocityMarker*> mVelMarkers;
-    QMap<uint32_t, StrategicSymbol*> mTracks;
+    QHash<uint32_t, StrategicSymbol*> mTracks; // Live symbols only
+    QVector<StrategicSymbol*> mFreeSymbols; // Retired symbols, hidden but kept in the scene for reuse
+    TrackClusterItem* mClusterItem;
+
+    // Reused between ticks
+    QVector<QPair<quint64, StrategicSymbol*>> mCells; // Sorted (cell, symbol) pairs
+    QVector<TrackCluster> mClusters;
 };
 
 
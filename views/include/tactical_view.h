@@ -1,9 +1,15 @@
+#include "phosphor_buffer.h"
+
 #include <QFrame>
 #include <QGraphicsView>
 #include <QtWidgets>
 
 #pragma once
 
+class Asteroid;
+class Starfield;
+class MissileBatchItem;
+
 
 class TacticalView : public QGraphicsView
 {
@@ -13,8 +19,23 @@ public:
 
     void toggleZoom();
 
+    /**
+     * Advances the phosphor persistence by one tick.
+     * @param offset - Movement of the world since the last tick, in scene coordinates.
+     * @param contacts - Items that leave a trail.
+     * @param missiles - Missiles that leave a trail, if any.
+     * @param ghosts - One-off outlines to burn in, in scene coordinates.
+     */
+    void updatePhosphor(QPointF offset, const QVector<QGraphicsItem*>& contacts, MissileBatchItem* missiles,
+                        const QVector<QPolygonF>& ghosts);
+
+protected:
+    void drawForeground(QPainter* painter, const QRectF& rect) override;
+
 private:
     bool mZoomed = true;
+    PhosphorBuffer mPhosphor;
+    QVector<QRectF> mMissileRects; // Reused between ticks
 };
 
 class TacticalScene : public QGraphicsScene
@@ -27,13 +48,45 @@ public:
     void initAsteroidField();
 
     void updateItems(QPointF offset);
+
+    /**
+     * Adds a dynamic item to the scene and to the registry it is updated from.
+     * The scene takes ownership.
+     */
+    void addAsteroid(Asteroid* asteroid);
+    void addStarfield(Starfield* starfield);
+
+    /**
+     * Adds a moving contact to the scene, which leaves a phosphor trail if trails are enabled.
+     * The scene takes ownership.
+     */
+    void addContact(QGraphicsItem* item);
+
+    /**
+     * Burns the outline of the polygon into the phosphor on the next tick.
+     * @param poly - Outline in scene coordinates.
+     */
+    void addGhost(const QPolygonF& poly);
+
+    void setTrailsEnabled(bool enabled) { mTrailsEnabled = enabled; }
+
     TacticalView* getView() const;
+    MissileBatchItem* getMissileBatch() const { return mMissileBatch; }
+    const QVector<Asteroid*>& getAsteroids() const { return mAsteroids; }
 
 public Q_SLOTS:
     void toggleZoom();
 
 private:
     TacticalView* mView;
+
+    // Registries of the items moved every tick, so updates never walk or cast the whole scene
+    QVector<Asteroid*> mAsteroids;
+    QVector<Starfield*> mStarfields;
+    MissileBatchItem* mMissileBatch;
+    QVector<QGraphicsItem*> mContacts;
+    QVector<QPolygonF> mGhosts; // Pending until the next tick
+    bool mTrailsEnabled = true;
 };
 
 
@@ -173,21 +173,21 @@ void ConfigScene::updateStats(QString mass, QString linearAcc, QString leftAcc,
     mTextSensors->updateText(hasSensors);
 }
 
-void ConfigScene::drawConfigComponent(std::shared_ptr<Component> component)
+void ConfigScene::drawConfigComponent(const Component& component)
 {
-    mTempItems << addPolygon(component->getPoly(),
-                             component->isValid() ? QPen(QColor(0, 255, 0)) : QPen(QColor(255, 0, 0)));
-    if (!component->getTexturePoly().isEmpty())
+    mTempItems << addPolygon(component.getPoly(),
+                             component.isValid() ? QPen(QColor(0, 255, 0)) : QPen(QColor(255, 0, 0)));
+    if (!Component::getTextureShape(component.getType()).isEmpty())
     {
-        mTempItems << addPolygon(component->getTexturePoly(), QPen(QColor(0, 0, 0, 0)),
-                                 component->isValid() ? QBrush(QColor(0, 255, 0)) : QBrush(QColor(255, 0, 0)));
+        mTempItems << addPolygon(component.getTexturePoly(), QPen(QColor(0, 0, 0, 0)),
+                                 component.isValid() ? QBrush(QColor(0, 255, 0)) : QBrush(QColor(255, 0, 0)));
     }
 }
 
-void ConfigScene::drawConfigEngine(std::shared_ptr<Engine> engine)
+void ConfigScene::drawConfigEngine(const Engine& engine, const Component& component)
 {
-    mTempItems << addPolygon(engine->getPoly(),
-                             engine->getComponent()->isValid() ? QPen(QColor(0, 255, 0)) : QPen(QColor(255, 0, 0)),
+    mTempItems << addPolygon(engine.getPoly(),
+                             component.isValid() ? QPen(QColor(0, 255, 0)) : QPen(QColor(255, 0, 0)),
                              QBrush(QColor(0, 0, 0)));
 }
 
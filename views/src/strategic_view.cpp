@@ -11,26 +11,43 @@ StrategicView::StrategicView(QGraphicsScene* scene) : QGraphicsView()
 {
     setStyleSheet("border: 1px solid green");
     setScene(scene);
+    // Items report their own changes, so only repaint the regions they invalidate
+    setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    setCacheMode(QGraphicsView::CacheBackground);
+    // Bounding rects already include the antialiasing margin
+    setOptimizationFlags(QGraphicsView::DontAdjustForAntialiasing);
     ensureVisible(QRectF(0, 0, 0, 0));
 }
 
 void StrategicView::toggleZoom()
 {
-    if (mZoomed) {
-        scale(0.5, 0.5);
-    } else {
-        scale(2.0, 2.0);
-    }
-    mZoomed = !mZoomed;
+    setZoom(mZoom < 1 ? 1 : 0.5);
+}
+
+void StrategicView::setZoom(qreal zoom)
+{
+    mZoom = qBound(sMinZoom, zoom, sMaxZoom);
+    setTransform(QTransform::fromScale(mZoom, mZoom));
+}
+
+void StrategicView::wheelEvent(QWheelEvent* event)
+{
+    setZoom(mZoom * qPow(sWheelStep, event->angleDelta().y() / 120.0));
+    event->accept();
 }
 
 StrategicScene::StrategicScene(QWidget* parent) : QGraphicsScene(parent)
 {
+    // Nearly every item moves each tick, so a BSP index costs more to maintain than it saves
+    setItemIndexMethod(QGraphicsScene::NoIndex);
     initBackground();
     setSceneRect(QRectF(-100, -100, 200, 200));
     mView = new StrategicView(this);
     mPlayerSymbol = new PlayerSymbolItem({0, 0});
     addItem(mPlayerSymbol);
+    mClusterItem = new TrackClusterItem();
+    mClusterItem->setZValue(1);
+    addItem(mClusterItem);
     for (int i = 1; i <= 6; i++) {
         auto velItem = new VelocityMarker(i * 10 * gTargetFramerate);
         auto accItem = new AccelerationMarker(i * 10 * gTargetFramerate);
@@ -41,23 +58,32 @@ StrategicScene::StrategicScene(QWidget* parent) : QGraphicsScene(parent)
     }
 }
 
-void StrategicScene::visualiseTracks(const QVector<SignalTrackProcessor::ProcessedTrack>& tracks)
+void StrategicScene::visualiseTracks(TrackView tracks)
 {
-    for (auto track : tracks) {
+    for (const auto& track : tracks) {
         updateTrack(track);
     }
 }
 
-void StrategicScene::updateTrack(SignalTrackProcessor::ProcessedTrack track)
+void StrategicScene::updateTrack(const ProcessedTrack& track)
 {
-    qreal x = track.offset.x() * gScaleFactor;
-    qreal y = track.offset.y() * gScaleFactor;
-    if (!mTracks.contains(track.uid)) {
-        auto item = new StrategicSymbol();
-        mTracks[track.uid] = item;
-        addItem(item);
+    // The player ship is at the origin, so world coordinates are already relative to it
+    qreal x = track.position.x() * gScaleFactor;
+    qreal y = track.position.y() * gScaleFactor;
+    StrategicSymbol* item = mTracks.value(track.uid, nullptr);
+    if (!item)
+    {
+        if (mFreeSymbols.empty()) {
+            item = new StrategicSymbol();
+            addItem(item);
+        } else {
+            item = mFreeSymbols.takeLast();
+            item->reset();
+            item->setVisible(true);
+        }
+        mTracks.insert(track.uid, item);
     }
-    mTracks[track.uid]->updateTrack(x, y, track.vel * gScaleFactor, track.faction, track.isCurrent);
+    item->updateTrack(x, y, track.vel * gScaleFactor, track.faction, track.isCurrent);
 }
 
 void StrategicScene::applyPlayerUpdate(QPointF posOffset, Bearing angle, Vector vel, Vector acc)
@@ -73,9 +99,63 @@ void StrategicScene::applyPlayerUpdate(QPointF posOffset, Bearing angle, Vector
                   [vel, acc](auto v){ v->updateOffset(vel, acc); });
     mGridLines->updateOffset(posOffset);
 
-    for (auto item : mTracks) {
+    for (auto it = mTracks.begin(); it != mTracks.end();)
+    {
+        auto item = it.value();
         item->updateOffset(posOffset);
+        if (item->isExpired()) {
+            // Lost for the whole symbol lifetime, so retire it to the pool
+            item->setVisible(false);
+            mFreeSymbols << item;
+            it = mTracks.erase(it);
+        } else {
+            it++;
+        }
+    }
+    clusterTracks();
+}
+
+void StrategicScene::clusterTracks()
+{
+    qreal cellSize = sClusterPixels / mView->getZoom();
+    mCells.clear();
+    for (auto item : mTracks)
+    {
+        auto cx = quint32(qFloor(item->x() / cellSize));
+        auto cy = quint32(qFloor(item->y() / cellSize));
+        mCells.append({(quint64(cx) << 32) | cy, item});
     }
+    std::sort(mCells.begin(), mCells.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    mClusters.clear();
+    for (int start = 0, end = 0; start < mCells.size(); start = end)
+    {
+        end = start + 1;
+        while (end < mCells.size() && mCells[end].first == mCells[start].first) {
+            end++;
+        }
+        if (end - start == 1) {
+            mCells[start].second->setVisible(true);
+            continue;
+        }
+
+        // Mixed factions are drawn as unknown
+        QPointF centroid;
+        QColor colour = mCells[start].second->getColour();
+        for (int i = start; i < end; i++)
+        {
+            auto item = mCells[i].second;
+            item->setVisible(false);
+            centroid += item->pos();
+            if (item->getColour().rgb() != colour.rgb()) {
+                colour = QColor(255, 155, 0);
+            }
+        }
+        colour.setAlpha(255);
+        mClusters.append({centroid / (end - start), end - start, colour});
+    }
+    mClusterItem->setClusters(mClusters, mView->getZoom());
 }
 
 /*
@@ -108,6 +188,7 @@ void StrategicScene::initBackground()
 {
     setBackgroundBrush(QColor(0, 0, 15));
     mGridLines = new GridLines(200);
+    mGridLines->setZValue(-1);
     addItem(mGridLines);
 }
 
@@ -119,4 +200,9 @@ StrategicView* StrategicScene::getView() const
 void StrategicScene::toggleZoom()
 {
     mView->toggleZoom();
+}
+
+void StrategicScene::setZoom(qreal zoom)
+{
+    mView->setZoom(zoom);
 }
\ No newline at end of file
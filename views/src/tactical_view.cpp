@@ -1,7 +1,7 @@
 #include "include/tactical_view.h"
 #include "include/starfield.h"
 #include "include/asteroid.h"
-#include "include/phosphor_ghost.h"
+#include "include/missile_batch_item.h"
 
 #include <QtWidgets>
 #include <QGraphicsView>
@@ -13,6 +13,11 @@ TacticalView::TacticalView(QGraphicsScene* scene) : QGraphicsView()
 {
     setStyleSheet("border: 1px solid green");
     setScene(scene);
+    // Items report their own changes, so only repaint the regions they invalidate
+    setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    setCacheMode(QGraphicsView::CacheBackground);
+    // Bounding rects already include the antialiasing margin
+    setOptimizationFlags(QGraphicsView::DontAdjustForAntialiasing);
     ensureVisible(QRectF(0, 0, 0, 0));
 }
 
@@ -26,54 +31,112 @@ void TacticalView::toggleZoom()
     mZoomed = !mZoomed;
 }
 
+void TacticalView::updatePhosphor(QPointF offset, const QVector<QGraphicsItem*>& contacts, MissileBatchItem* missiles,
+                                  const QVector<QPolygonF>& ghosts)
+{
+    mPhosphor.resize(viewport()->size());
+    QTransform transform = viewportTransform();
+    mPhosphor.decay(transform.map(offset) - transform.map(QPointF(0, 0)));
+    for (auto item : contacts) {
+        mPhosphor.deposit(item, transform);
+    }
+    if (missiles)
+    {
+        // The batch spans every missile, on screen or not, so only each visible missile is lit
+        missiles->getMissileRects(mapToScene(viewport()->rect()).boundingRect(), mMissileRects);
+        mPhosphor.deposit(missiles, transform, mMissileRects);
+    }
+    for (const auto& poly : ghosts) {
+        mPhosphor.deposit(poly, transform);
+    }
+    // Only the lit part of the screen changes
+    viewport()->update(mPhosphor.getDirtyRect());
+}
+
+void TacticalView::drawForeground(QPainter* painter, const QRectF& rect)
+{
+    Q_UNUSED(rect);
+    if (!mPhosphor.isLit()) {
+        return;
+    }
+    painter->save();
+    painter->resetTransform();
+    mPhosphor.draw(painter);
+    painter->restore();
+}
+
 TacticalScene::TacticalScene(QWidget* parent) : QGraphicsScene(parent)
 {
+    // Nearly every item moves each tick, so a BSP index costs more to maintain than it saves
+    setItemIndexMethod(QGraphicsScene::NoIndex);
     initBackground();
     setSceneRect(QRectF(-100, -100, 200, 200));
     mView = new TacticalView(this);
+
+    // Every missile is drawn by the one batch item, which leaves trails like any other contact
+    mMissileBatch = new MissileBatchItem();
+    addItem(mMissileBatch);
 }
 
 void TacticalScene::updateItems(QPointF offset)
 {
-    QList<QGraphicsItem*> forDeletion;
-    for (QGraphicsItem *item: items()) {
-        if (auto a = dynamic_cast<Asteroid*>(item))
-        {
-            a->posUpdate(offset);
-            a->update();
-        }
-        else if (auto g = dynamic_cast<PhosphorGhost*>(item))
-        {
-            if (g->isDone()) forDeletion << g;
-            g->posUpdate(offset);
-            g->update();
-        }
-        else if (auto s = dynamic_cast<Starfield*>(item))
-        {
-            s->updateOffset(offset);
-            s->update();
-        }
+    for (auto a : mAsteroids)
+    {
+        a->posUpdate(offset);
+        a->update();
     }
 
-    for (auto i : forDeletion) removeItem(i);
+    for (auto s : mStarfields) {
+        s->updateOffset(offset);
+    }
 
-    //auto ghost = new PhosphorGhost(mPlayer->getPoly(), 20);
-    //scene()->addItem(ghost);
+    mMissileBatch->sync(mView->mapToScene(mView->viewport()->rect()).boundingRect());
+
+    if (mTrailsEnabled) {
+        mView->updatePhosphor(offset, mContacts, mMissileBatch, mGhosts);
+    } else {
+        mView->updatePhosphor(offset, {}, nullptr, mGhosts);
+    }
+    mGhosts.clear();
+}
+
+void TacticalScene::addAsteroid(Asteroid* asteroid)
+{
+    addItem(asteroid);
+    mAsteroids << asteroid;
+}
+
+void TacticalScene::addContact(QGraphicsItem* item)
+{
+    addItem(item);
+    mContacts << item;
+}
+
+void TacticalScene::addGhost(const QPolygonF& poly)
+{
+    mGhosts << poly;
+}
+
+void TacticalScene::addStarfield(Starfield* starfield)
+{
+    starfield->setZValue(-1);
+    addItem(starfield);
+    mStarfields << starfield;
 }
 
 void TacticalScene::initBackground()
 {
     setBackgroundBrush(QColor(0, 0, 15));
 
-    addItem(new Starfield(QPointF(0, 0), 0.3, 17));
-    addItem(new Starfield(QPointF(0, 0), 0.5, 35));
-    addItem(new Starfield(QPointF(0, 0), 1.0, 29));
+    addStarfield(new Starfield(QPointF(0, 0), 0.3, 17));
+    addStarfield(new Starfield(QPointF(0, 0), 0.5, 35));
+    addStarfield(new Starfield(QPointF(0, 0), 1.0, 29));
 }
 
 void TacticalScene::initAsteroidField()
 {
     auto asteroid = new Asteroid(QColor(0, 255, 0), 0, -200, Vector(0, 0), 10, 25);
-    addItem(asteroid);
+    addAsteroid(asteroid);
 }
 
 TacticalView* TacticalScene::getView() const
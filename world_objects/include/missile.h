@@ -1,5 +1,4 @@
 #include "include/world_object.h"
-#include "include/missile_item.h"
 #include "include/radar_sensor.h"
 
 
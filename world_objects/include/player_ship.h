@@ -1,8 +1,9 @@
 #include "include/world_object.h"
-#include "blur.h"
 #include "include/engine.h"
+#include "include/engine_notifier.h"
 #include "include/component.h"
 #include "include/player_ship_item.h"
+#include "include/heat_flow.h"
 
 #include <QGraphicsItem>
 #include <QtMath>
@@ -46,17 +47,17 @@ public:
      * Add a sensor to the player ship based on the component position
      * and type.
      *
-     * @param c - The component to use for adding the sensor.
+     * @param index - Index of the component to use for adding the sensor.
      */
-    void createComponentSensors(std::shared_ptr<Component>& c);
+    void createComponentSensors(int index);
 
     /**
      * Add engines to the player ship based on the component position
      * and type.
      *
-     * @param c - The component to use for adding engines.
+     * @param index - Index of the component to use for adding engines.
      */
-    void createComponentEngines(std::shared_ptr<Component>& c);
+    void createComponentEngines(int index);
 
     void computeCentreOfRotation();
     void computeProperties();
@@ -83,6 +84,14 @@ public:
      */
     void update();
 
+    const QVector<Component>& getComponents() const { return mComponents; }
+    const QVector<Engine>& getEngines() const { return mEngines; }
+
+    /**
+     * Returns a counter that changes every time the ship is reconfigured.
+     */
+    uint32_t getConfigRevision() const { return mConfigRevision; }
+
     void resetMovement();
     void enableForward() { mForwardThrust = true; }
     void enableBackward() { mBackwardThrust = true; }
@@ -99,8 +108,8 @@ public Q_SLOTS:
 Q_SIGNALS:
     void displayText(QString);
     void handleUpdateConfigStats(QString, QString, QString, QString, QString);
-    void handleAddConfigComponent(std::shared_ptr<Component>);
-    void handleAddConfigEngine(std::shared_ptr<Engine>);
+    void handleAddConfigComponent(const Component&);
+    void handleAddConfigEngine(const Engine&, const Component&);
     void handleAddCentreOfMass(qreal, qreal);
     void handleAddCentreOfRotation(qreal, qreal);
     void handleRemoveAllConfigItems();
@@ -109,7 +118,19 @@ Q_SIGNALS:
 private:
     bool hasPathToReactor(int x, int y);
 
-    QPair<qreal, qreal> getSensorLimits(std::shared_ptr<Component> owner, qreal boreAngle);
+    /**
+     * Adds the given component to the contiguous component storage,
+     * replacing any component already at the same coordinate.
+     */
+    void insertComponent(const Component& component);
+
+    /**
+     * Removes the component at the given coordinate and re-indexes
+     * the remaining components.
+     */
+    void removeComponent(int x, int y);
+
+    QPair<qreal, qreal> getSensorLimits(const Component& owner, qreal boreAngle);
 
     void parseStats();
 
@@ -121,12 +142,16 @@ private:
     bool mRotateRightThrust = false;
 
     bool mCanRotate = false;
+    uint32_t mConfigRevision = 0;
 
     qreal mM = 0; // Mass
     qreal mI = 0; // Inertia
     Vector mCentreOfMass = Vector(0, 0);
     Vector mCentreOfRotation = Vector(0, 0);
 
-    QVector<std::shared_ptr<Engine>> mEngines;
-    QMap<QPair<int, int>, std::shared_ptr<Component>> mComponentMap;
+    QVector<Engine> mEngines;
+    QVector<Component> mComponents;
+    QMap<QPair<int, int>, int> mComponentMap; // Coordinate -> index into mComponents
+    EngineNotifier mEngineNotifier;
+    HeatFlow mHeatFlow {mComponents};
 };
@@ -35,7 +35,20 @@ public:
     Bearing getAtan2() const { return mAtan2; }
     QGraphicsItem* getTacticalGraphicsItem() { return mTacticalGraphicsItem; }
     uint32_t getId() const { return mId; }
+    Faction getFaction() const { return mFaction; }
     QVector<std::shared_ptr<Sensor>> getSensors() const { return mSensors; }
+    qreal getCrossSection() const { return mCrossSection; }
+    qreal getRadius() const { return mRadius; }
+
+    /**
+     * Sets the radar cross-section of the object.
+     * @param crossSection - Cross-section relative to a reference target of 1, must be positive.
+     */
+    void setCrossSection(qreal crossSection)
+    {
+        mCrossSection = crossSection;
+        mRootCrossSectionInv = 1.0 / qSqrt(crossSection);
+    }
 
     constexpr static qreal deltaT {1.0f};
 
@@ -44,7 +57,7 @@ public:
     void updateSensors()
     {
         for (const auto& s : mSensors) {
-            s->update({mP.x(), mP.y()}, mAtan2);
+            s->update();
         }
     }
 
@@ -70,6 +83,9 @@ protected:
     Vector mV = Vector(0, 0); // Velocity vector
     Vector mA = Vector(0, 0); // Acceleration vector
     Vector mP = Vector(0, 0); // Position vector
+    qreal mCrossSection = 1; // Radar cross-section
+    qreal mRootCrossSectionInv = 1; // Cached 1/sqrt(mCrossSection) for the detection model
+    qreal mRadius = 0; // Extent for line-of-sight occlusion, 0 if the object is too small to block anything
     qreal mMaxRightRotateAcc = 0;
     qreal mMaxLeftRotateAcc = 0;
 
@@ -9,7 +9,7 @@ Missile::Missile(Faction faction, Vector initialPos, Vector initialVel, qreal at
     mMaxRightRotateAcc = 0.001;
     mMaxLeftRotateAcc = 0.001;
     mAtan2 = atan2;
-    mTacticalGraphicsItem = new MissileItem(mP, mAtan2);
+    setCrossSection(0.1);
     mSensors << std::make_shared<RadarSensor>(this,
                                               0,
                                               1.5, 1.5,
@@ -36,5 +36,4 @@ void Missile::updatePosition(QPointF offset)
     mV += mA * deltaT;
     mP += mV * deltaT;
     mP += Vector(offset.x(), offset.y());
-    mTacticalGraphicsItem->setPos({mP.x(), mP.y()});
 }
\ No newline at end of file
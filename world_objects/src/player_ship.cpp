@@ -1,13 +1,13 @@
 #include "include/player_ship.h"
 #include "include/mini_engine.h"
 #include "include/cruise_engine.h"
-#include "include/heat_flow.h"
 #include "include/radar_sensor.h"
 
 
 PlayerShip::PlayerShip(Faction faction, uint32_t uid) : WorldObject(faction, uid)
 {
-    mTacticalGraphicsItem = new PlayerShipItem(mAtan2);
+    mTacticalGraphicsItem = new PlayerShipItem();
+    connect(&mEngineNotifier, &EngineNotifier::transmitStatus, this, &PlayerShip::receiveTextFromComponent);
 }
 
 void PlayerShip::update()
@@ -31,84 +31,79 @@ void PlayerShip::update()
 
     mA = {0, 0};
     mRotA = 0;
-    for (const auto& e : mEngines)
+    for (auto& e : mEngines)
     {
+        auto& c = mComponents[e.getComponentIndex()];
+
         // Determine if the engine should be fired
         bool enable = false;
-        switch (e->getComponent()->getType())
+        switch (c.getType())
         {
             case CT::RotateThruster:
-                if (mLeftThrust && e->isLateralLeftAcc()) enable = true;
-                if (mRightThrust && e->isLateralRightAcc()) enable = true;
-                if (mRotateLeftThrust && e->isRotateLeftAcc()) enable = true;
-                if (mRotateRightThrust && e->isRotateRightAcc()) enable = true;
+                if (mLeftThrust && e.isLateralLeftAcc()) enable = true;
+                if (mRightThrust && e.isLateralRightAcc()) enable = true;
+                if (mRotateLeftThrust && e.isRotateLeftAcc()) enable = true;
+                if (mRotateRightThrust && e.isRotateRightAcc()) enable = true;
             case CT::CruiseThruster:
-                if (mForwardThrust && e->isForwardAcc()) enable = true;
-                if (mBackwardThrust && e->isBackwardAcc()) enable = true;
+                if (mForwardThrust && e.isForwardAcc()) enable = true;
+                if (mBackwardThrust && e.isBackwardAcc()) enable = true;
             default:;
         }
 
         if (enable)
-            e->incrementAccProfile();
+            e.incrementAccProfile(c);
         else
-            e->decrementAccProfile();
+            e.decrementAccProfile(c);
 
         // Update velocity if engine is firing
-        if (e->enabled()) {
-            mA += Vector(mAtan2) * e->getLongitudinalAcc();
-            mA += Vector(mAtan2 + M_PI_2) * e->getLateralAcc();
-            mRotA += e->getRotationalAcc();
+        if (e.enabled()) {
+            mA += Vector(mAtan2) * e.getLongitudinalAcc();
+            mA += Vector(mAtan2 + M_PI_2) * e.getLateralAcc();
+            mRotA += e.getRotationalAcc();
         }
     }
 
     // Temperature flow modelling between components
-    HeatFlow hf {mComponentMap};
-    hf.compute();
+    mHeatFlow.compute();
 
     mRotV += mRotA * deltaT;
     mV += mA * deltaT;
 
     mAtan2 += mRotV * deltaT;
-    mTacticalGraphicsItem->update();
 }
 
 void PlayerShip::addReactor(int x, int y)
 {
     // Do not allow more than one reactor
-    for (const auto& c : mComponentMap)
+    for (const auto& c : mComponents)
     {
-        if (c->getType() == CT::Reactor)
+        if (c.getType() == CT::Reactor)
         {
-            handleRemovePart({c->x(), c->y()});
+            handleRemovePart({c.x(), c.y()});
             break;
         }
     }
-    auto component = std::make_shared<Component>(CT::Reactor, x, y);
-    mComponentMap[QPair{x, y}] = component;
+    insertComponent(Component(CT::Reactor, x, y));
 }
 
 void PlayerShip::addHeatSink(int x, int y)
 {
-    auto component = std::make_shared<Component>(CT::HeatSink, x, y);
-    mComponentMap[QPair{x, y}] = component;
+    insertComponent(Component(CT::HeatSink, x, y));
 }
 
 void PlayerShip::addRotateThruster(int x, int y)
 {
-    auto component = std::make_shared<Component>(CT::RotateThruster,x, y);
-    mComponentMap[QPair{x, y}] = component;
+    insertComponent(Component(CT::RotateThruster, x, y));
 }
 
 void PlayerShip::addCruiseThruster(int x, int y, TwoDeg direction)
 {
-    auto component = std::make_shared<Component>(CT::CruiseThruster, x, y, direction);
-    mComponentMap[QPair{x, y}] = component;
+    insertComponent(Component(CT::CruiseThruster, x, y, direction));
 }
 
 void PlayerShip::addSensor(int x, int y, TwoDeg direction)
 {
-    auto component = std::make_shared<Component>(CT::RADAR, x, y, direction);
-    mComponentMap[QPair{x, y}] = component;
+    insertComponent(Component(CT::RADAR, x, y, direction));
 }
 
 template<class T>
@@ -118,8 +113,7 @@ void PlayerShip::computeEngineDirectionForce(int x, int y, TwoDeg direction)
     Vector offset = Vector(qreal((x+0.5)-gGridSize*0.5)*gBlockSize,
                            qreal((y+0.5)-gGridSize*0.5)*gBlockSize)
                     - mCentreOfMass;
-    auto engine = std::make_shared<T>(mComponentMap[QPair(x, y)], direction, offset, mM, mI);
-    connect(engine.get(), &Engine::transmitStatus, this, &PlayerShip::receiveTextFromComponent);
+    T engine(mComponentMap.value(QPair(x, y)), &mEngineNotifier, direction, offset, mM, mI);
 
     // For visualising active thrusters
     qreal scenePosX = ((x+0.5) - (gGridSize*0.5)) * gGridSize * 2.0;
@@ -138,31 +132,32 @@ void PlayerShip::computeEngineDirectionForce(int x, int y, TwoDeg direction)
             scenePosX -= gGridSize;
             break;
     }
-    engine->createPoly(QPointF(scenePosX, scenePosY));
+    engine.setMarker(QPointF(scenePosX, scenePosY));
     mEngines << engine;
 }
 
 void PlayerShip::computeRotationalInertia()
 {
     mI = 0;
-    mI = std::accumulate(mComponentMap.cbegin(), mComponentMap.cend(), mI,
-                    [this](auto inertia, auto c)
+    mI = std::accumulate(mComponents.cbegin(), mComponents.cend(), mI,
+                    [this](auto inertia, const auto& c)
                     {
-                        inertia += c->getMass()
-                                   *(qPow(qreal((c->x()+0.5)-gGridSize*0.5)*gBlockSize - mCentreOfMass.x(), 2.0)
-                                     + qPow(qreal((c->y()+0.5)-gGridSize*0.5)*gBlockSize - mCentreOfMass.y(), 2.0));
+                        inertia += c.getMass()
+                                   *(qPow(qreal((c.x()+0.5)-gGridSize*0.5)*gBlockSize - mCentreOfMass.x(), 2.0)
+                                     + qPow(qreal((c.y()+0.5)-gGridSize*0.5)*gBlockSize - mCentreOfMass.y(), 2.0));
                         return inertia;
                     });
 }
 
-void PlayerShip::createComponentSensors(std::shared_ptr<Component>& c)
+void PlayerShip::createComponentSensors(int index)
 {
-    if (c->getType() != CT::RADAR)
+    auto& c = mComponents[index];
+    if (c.getType() != CT::RADAR)
         return;
 
-    TwoDeg direction = c->getDirection();
-    c->setValid(false);
-    if (isGridLineFree(c->x(), c->y(), direction, true))
+    TwoDeg direction = c.getDirection();
+    c.setValid(false);
+    if (isGridLineFree(c.x(), c.y(), direction, true))
     {
         qreal angle = 0;
         switch (direction)
@@ -176,50 +171,51 @@ void PlayerShip::createComponentSensors(std::shared_ptr<Component>& c)
         mSensors << std::make_shared<RadarSensor>(this,
                                                   angle,
                                                   sensorLimits.first, sensorLimits.second);
-        c->setValid(true);
+        c.setValid(true);
     }
 }
 
 void PlayerShip::createAllSubComponents()
 {
     computeRotationalInertia();
-    for (auto c : mComponentMap)
+    for (int i = 0; i < mComponents.size(); i++)
     {
-        createComponentEngines(c);
-        createComponentSensors(c);
+        createComponentEngines(i);
+        createComponentSensors(i);
     }
 }
 
-void PlayerShip::createComponentEngines(std::shared_ptr<Component>& c)
+void PlayerShip::createComponentEngines(int index)
 {
+    auto& c = mComponents[index];
     bool hasValidEngine = false;
     bool hasEngine = false;
-    if (c->getType() == CT::RotateThruster)
+    if (c.getType() == CT::RotateThruster)
     {
         // For each unique direction
         for (int i = 0; i < 4; i++) {
             auto direction = static_cast<TwoDeg>(i);
-            if (isGridLineFree(c->x(), c->y(), direction))
+            if (isGridLineFree(c.x(), c.y(), direction))
             {
-                computeEngineDirectionForce<MiniEngine>(c->x(), c->y(), direction);
+                computeEngineDirectionForce<MiniEngine>(c.x(), c.y(), direction);
                 hasValidEngine = true;
             }
         }
         hasEngine = true;
     }
-    if (c->getType() == CT::CruiseThruster)
+    if (c.getType() == CT::CruiseThruster)
     {
-        TwoDeg direction = c->getDirection();
-        if (isGridLineFree(c->x(), c->y(), direction))
+        TwoDeg direction = c.getDirection();
+        if (isGridLineFree(c.x(), c.y(), direction))
         {
-            computeEngineDirectionForce<CruiseEngine>(c->x(), c->y(), direction);
+            computeEngineDirectionForce<CruiseEngine>(c.x(), c.y(), direction);
             hasValidEngine = true;
         }
         hasEngine = true;
     }
     if (hasEngine && !hasValidEngine)
     {
-        c->setValid(false);
+        c.setValid(false);
     }
 }
 
@@ -238,23 +234,24 @@ void PlayerShip::computeCentreOfRotation()
     mMaxLeftRotateAcc = 0;
     for (const auto& e : mEngines)
     {
-        if (e->getComponent()->getType() == CT::CruiseThruster)
+        const auto& c = mComponents[e.getComponentIndex()];
+        if (c.getType() == CT::CruiseThruster)
             continue;
-        if (e->isRotateLeftAcc())
+        if (e.isRotateLeftAcc())
         {
-            leftRotate += Vector(qreal((e->getComponent()->x()+0.5)-(gGridSize*0.5))*gBlockSize,
-                                 qreal((e->getComponent()->y()+0.5)-(gGridSize*0.5))*gBlockSize) * e->getComponent()->getMass();
-            leftRotateEffectiveMass += e->getComponent()->getMass();
+            leftRotate += Vector(qreal((c.x()+0.5)-(gGridSize*0.5))*gBlockSize,
+                                 qreal((c.y()+0.5)-(gGridSize*0.5))*gBlockSize) * c.getMass();
+            leftRotateEffectiveMass += c.getMass();
             mCanRotate = true;
-            mMaxLeftRotateAcc += -e->getMaxRotationalAcc();
+            mMaxLeftRotateAcc += -e.getMaxRotationalAcc();
         }
-        else if (e->isRotateRightAcc())
+        else if (e.isRotateRightAcc())
         {
-            rightRotate += Vector(qreal((e->getComponent()->x()+0.5)-(gGridSize*0.5))*gBlockSize,
-                                  qreal((e->getComponent()->y()+0.5)-(gGridSize*0.5))*gBlockSize) * e->getComponent()->getMass();
-            rightRotateEffectiveMass += e->getComponent()->getMass();
+            rightRotate += Vector(qreal((c.x()+0.5)-(gGridSize*0.5))*gBlockSize,
+                                  qreal((c.y()+0.5)-(gGridSize*0.5))*gBlockSize) * c.getMass();
+            rightRotateEffectiveMass += c.getMass();
             mCanRotate = true;
-            mMaxRightRotateAcc += e->getMaxRotationalAcc();
+            mMaxRightRotateAcc += e.getMaxRotationalAcc();
         }
     }
     leftRotate *= 1.0/leftRotateEffectiveMass;
@@ -278,18 +275,27 @@ void PlayerShip::computeProperties()
 {
     mM = 0;
     mCentreOfMass = Vector(0, 0);
-    for (auto c : mComponentMap)
+    for (auto& c : mComponents)
     {
-        c->setValid(true);
-        if (!hasPathToReactor(c->x(), c->y()))
+        c.setValid(true);
+        if (!hasPathToReactor(c.x(), c.y()))
         {
-            c->setValid(false);
+            c.setValid(false);
         }
-        mCentreOfMass += Vector(qreal((c->x()+0.5)-(gGridSize*0.5))*gBlockSize,
-                                qreal((c->y()+0.5)-(gGridSize*0.5))*gBlockSize) * c->getMass();
-        mM += c->getMass();
+        mCentreOfMass += Vector(qreal((c.x()+0.5)-(gGridSize*0.5))*gBlockSize,
+                                qreal((c.y()+0.5)-(gGridSize*0.5))*gBlockSize) * c.getMass();
+        mM += c.getMass();
     }
     mCentreOfMass *= 1.0/mM;
+
+    // Furthest block corner from the centre of mass
+    mRadius = 0;
+    for (const auto& c : mComponents)
+    {
+        qreal dx = qreal((c.x()+0.5)-(gGridSize*0.5))*gBlockSize - mCentreOfMass.x();
+        qreal dy = qreal((c.y()+0.5)-(gGridSize*0.5))*gBlockSize - mCentreOfMass.y();
+        mRadius = qMax(mRadius, qSqrt(dx*dx + dy*dy) + M_SQRT1_2*gBlockSize);
+    }
 }
 
 bool PlayerShip::isGridLineFree(int x, int y, TwoDeg direction, bool flip)
@@ -372,30 +378,23 @@ void PlayerShip::handleAddPart(CT compType, QPoint pos, TwoDeg direction)
 
 void PlayerShip::handleRemovePart(QPoint pos)
 {
-    QPair<int, int> pair {pos.x(), pos.y()};
     if (mComponentMap.contains({pos.x(), pos.y()}))
     {
-        mComponentMap.remove(pair);
+        removeComponent(pos.x(), pos.y());
         reconfigure();
     }
 }
 
 void PlayerShip::updateVisuals()
 {
-    // TODO: Make this less bad
-    auto playerItem = dynamic_cast<PlayerShipItem*>(mTacticalGraphicsItem);
-
     Q_EMIT handleRemoveAllConfigItems();
-    playerItem->reset();
-    for (const auto& c : mComponentMap)
+    for (const auto& c : mComponents)
     {
         Q_EMIT handleAddConfigComponent(c);
-        playerItem->addComponent(c);
     }
     for (const auto& e : mEngines)
     {
-        Q_EMIT handleAddConfigEngine(e);
-        playerItem->addEngine(e);
+        Q_EMIT handleAddConfigEngine(e, mComponents[e.getComponentIndex()]);
     }
     Q_EMIT handleAddCentreOfMass(mCentreOfMass.x(), mCentreOfMass.y());
     if (mCanRotate)
@@ -408,6 +407,8 @@ void PlayerShip::updateVisuals()
 
 void PlayerShip::reconfigure()
 {
+    mConfigRevision++;
+
     // Clear stuff
     mEngines.clear();
     Q_EMIT handleClearSensors(mSensors);
@@ -415,8 +416,10 @@ void PlayerShip::reconfigure()
 
     // Compute physics stuff
     computeProperties();
+    setCrossSection(qMax(1, mComponents.size()));
     createAllSubComponents();
     computeCentreOfRotation();
+    mHeatFlow.updateNeighbours(mComponentMap);
 
     parseStats();
     updateVisuals();
@@ -442,24 +445,45 @@ bool PlayerShip::hasPathToReactor(int x, int y)
     return std::any_of(checked.cbegin(), checked.cend(),
                        [this](auto c)
                        {
-                           return mComponentMap[{c>>4, c&0xF}]->getType() == CT::Reactor;
+                           return mComponents[mComponentMap.value({c>>4, c&0xF})].getType() == CT::Reactor;
                        });
 }
 
-QPair<qreal, qreal> PlayerShip::getSensorLimits(std::shared_ptr<Component> owner, qreal boreAngle)
+void PlayerShip::insertComponent(const Component& component)
+{
+    QPair<int, int> pair {component.x(), component.y()};
+    if (mComponentMap.contains(pair))
+    {
+        mComponents[mComponentMap[pair]] = component;
+        return;
+    }
+    mComponentMap[pair] = mComponents.size();
+    mComponents << component;
+}
+
+void PlayerShip::removeComponent(int x, int y)
+{
+    mComponents.remove(mComponentMap.take({x, y}));
+    for (int i = 0; i < mComponents.size(); i++)
+    {
+        mComponentMap[{mComponents[i].x(), mComponents[i].y()}] = i;
+    }
+}
+
+QPair<qreal, qreal> PlayerShip::getSensorLimits(const Component& owner, qreal boreAngle)
 {
     qreal minAngle = -0.75*M_PI;
     qreal maxAngle = 0.75*M_PI;
-    for (const auto& c : mComponentMap)
+    for (const auto& c : mComponents)
     {
-        if (c == owner) {
+        if (c.x() == owner.x() && c.y() == owner.y()) {
             continue;
         }
         // Compute the offset to every corner of every component
 
         for (int i = -1; i <= 1; i += 2) {
             for (int j = -1; j <= 1; j += 2) {
-                auto cornerOffset = Vector(qreal(c->x()+0.5+(i*0.5))-qreal(owner->x()+0.5), qreal(owner->y()+0.5+(j*0.5))-qreal(c->y()+0.5));
+                auto cornerOffset = Vector(qreal(c.x()+0.5+(i*0.5))-qreal(owner.x()+0.5), qreal(owner.y()+0.5+(j*0.5))-qreal(c.y()+0.5));
                 auto delta = Bearing(boreAngle).getDelta(cornerOffset.getAtan2());
                 if (delta < 0 && delta > minAngle) minAngle = delta;
                 if (delta > 0 && delta < maxAngle) maxAngle = delta;
@@ -473,7 +497,7 @@ void PlayerShip::parseStats()
 {
     QString mass = mM == 0 ? "" : QString("%1 KG").arg(mM);
     qreal totalThrust = 0;
-    std::for_each(mEngines.begin(), mEngines.end(), [&totalThrust](auto e){ totalThrust += e->getMaxThrust(); });
+    std::for_each(mEngines.cbegin(), mEngines.cend(), [&totalThrust](const auto& e){ totalThrust += e.getMaxThrust(); });
     QString acc = mM * totalThrust != 0 ? QString("%1 M/S^2").arg(100.0*totalThrust/mM) : "";
     QString leftAcc = mMaxLeftRotateAcc == 0 ? "" : QString("%1 S").arg(0.02*qSqrt(M_PI*4.0/mMaxLeftRotateAcc));
     QString rightAcc = mMaxRightRotateAcc == 0 ? "" : QString("%1 S").arg(0.02*qSqrt(M_PI*4.0/mMaxRightRotateAcc));